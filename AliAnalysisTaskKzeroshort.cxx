@@ -84,12 +84,19 @@ class AliAODv0;
 #include "AliESDHeader.h"
 #include "AliAODTrack.h"
 #include "AliAnalysisTaskKzeroshort.h"
+#include "AliStrangenessKernels.h"
 
 //debugging purposes
 #include "TObjectTable.h"
 
 ClassImp(AliAnalysisTaskKzeroshort)
 
+//Messages of the warning sites, same order as EWarning
+static const char *kKzeroshortWarnings[] = {
+  "Pb / | Z position of Best Prim Vtx | > 10.0 cm ... return !",
+  "Could not retreive one of the daughter tracks of the V0"
+};
+
 AliAnalysisTaskKzeroshort::AliAnalysisTaskKzeroshort() 
   : AliAnalysisTaskSE(),
   //Output lists
@@ -298,6 +305,9 @@ void AliAnalysisTaskKzeroshort::UserCreateOutputObjects()
   fOutput->Add( f2dHistResponsePionFromLambda          );
   fOutput->Add( f2dHistResponseProtonFromLambda        );
 
+  //Counters of the warnings of the event and V0 loops
+  fOutput->Add( fWarnings.Book("fHistWarnings", GetName(), kNWarnings, kKzeroshortWarnings) );
+
 //------------------------------------------------
 // Particle Identification Setup
 //------------------------------------------------
@@ -401,12 +411,13 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
 //------------------------------------------------
 
    if(TMath::Abs(lBestPrimaryVtxPos[2]) > 10.0 ) { 
-      AliWarning("Pb / | Z position of Best Prim Vtx | > 10.0 cm ... return !"); 
+      fWarnings.Count(kWarnVtxZ);
       PostData(1, fOutput);
       return; 
    }
 
    lMagneticField = lAODevent->GetMagneticField( );
+   fTrackCache.Reset(fPIDResponse, lMagneticField);
    //fHistEvent->Fill(3.5);  
   
 //------------------------------------------------
@@ -445,10 +456,7 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
       Double_t tDecayVertexV0[3]; v0->GetXYZ(tDecayVertexV0); 
       Double_t tV0mom[3];
       v0->GetPxPyPz( tV0mom ); 
-      Double_t lV0TotalMomentum = TMath::Sqrt(
-      tV0mom[0]*tV0mom[0]+tV0mom[1]*tV0mom[1]+tV0mom[2]*tV0mom[2] );
-
-      lV0Radius = TMath::Sqrt(tDecayVertexV0[0]*tDecayVertexV0[0]+tDecayVertexV0[1]*tDecayVertexV0[1]);
+      lV0Radius = AliStrangenessKernels::TransverseRadius(tDecayVertexV0);
       lPt = v0->Pt();
       lRapK0Short = v0->RapK0Short();
       lRapLambda  = v0->RapLambda();
@@ -465,7 +473,7 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
       AliAODTrack *pTrack=(AliAODTrack *)v0->GetDaughter(0); //0->Positive Daughter
       AliAODTrack *nTrack=(AliAODTrack *)v0->GetDaughter(1); //1->Negative Daughter
       if (!pTrack || !nTrack) {
-         Printf("ERROR: Could not retreive one of the daughter track");
+         fWarnings.Count(kWarnV0Daughters);
          continue;
       }
       // Filter like-sign V0 (next: add counter and distribution)
@@ -481,8 +489,8 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
 
       //________________________________________________________________________
       // Track quality cuts 
-      Float_t lPosTrackCrossedRows = pTrack->GetTPCClusterInfo(2,1);
-      Float_t lNegTrackCrossedRows = nTrack->GetTPCClusterInfo(2,1);
+      Float_t lPosTrackCrossedRows = fTrackCache.CrossedRows(pTrack);
+      Float_t lNegTrackCrossedRows = fTrackCache.CrossedRows(nTrack);
       Int_t lLeastNbrCrossedRows = (Int_t) lPosTrackCrossedRows;
       if( lNegTrackCrossedRows < lLeastNbrCrossedRows )
          lLeastNbrCrossedRows = (Int_t) lNegTrackCrossedRows;
@@ -536,19 +544,8 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
       lAlphaV0 = v0->AlphaV0();
       lPtArmV0 = v0->PtArmV0();
 
-      //Official means of acquiring N-sigmas 
-      Float_t lNSigmasPosProton = fPIDResponse->NumberOfSigmasTPC( pTrack, AliPID::kProton );
-      Float_t lNSigmasPosPion   = fPIDResponse->NumberOfSigmasTPC( pTrack, AliPID::kPion );
-      Float_t lNSigmasNegProton = fPIDResponse->NumberOfSigmasTPC( nTrack, AliPID::kProton );
-      Float_t lNSigmasNegPion   = fPIDResponse->NumberOfSigmasTPC( nTrack, AliPID::kPion );
-
 //This requires an Invariant Mass Hypothesis afterwards
-      Float_t lDistOverTotMom = TMath::Sqrt(
-						TMath::Power( tDecayVertexV0[0] - lBestPrimaryVtxPos[0] , 2) +
-						TMath::Power( tDecayVertexV0[1] - lBestPrimaryVtxPos[1] , 2) +
-						TMath::Power( tDecayVertexV0[2] - lBestPrimaryVtxPos[2] , 2)
-					);
-      lDistOverTotMom /= (lV0TotalMomentum+1e-10); //avoid division by zero, to be sure
+      Float_t lDistOverTotMom = AliStrangenessKernels::DistOverTotMom(tDecayVertexV0, lBestPrimaryVtxPos, tV0mom);
 
 
 //------------------------------------------------
@@ -560,7 +557,7 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
   fHistTopDCAPosToPV      -> Fill( lDcaPosToPrimVertex      ) ; 
   fHistTopDCAV0Daughters  -> Fill( lDcaV0Daughters          ) ; 
   fHistTopCosinePA        -> Fill( lV0CosineOfPointingAngle ) ; 
-  Float_t PL = lDistOverTotMom*0.497611;
+  Float_t PL = lDistOverTotMom*AliStrangenessKernels::kMassK0Short;
   fHistTopV0Radius        -> Fill( lDistOverTotMom ) ; 
 
 
@@ -576,6 +573,12 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
     fHistSelectedTopCosinePA        -> Fill( lV0CosineOfPointingAngle ) ; 
     fHistSelectedTopV0Radius        -> Fill( lV0Radius                ) ; 
 
+    //Official means of acquiring N-sigmas, only for the candidates passing the topological selection
+    Float_t lNSigmasPosProton = fTrackCache.NSigmaTPC( pTrack, AliPID::kProton );
+    Float_t lNSigmasPosPion   = fTrackCache.NSigmaTPC( pTrack, AliPID::kPion );
+    Float_t lNSigmasNegProton = fTrackCache.NSigmaTPC( nTrack, AliPID::kProton );
+    Float_t lNSigmasNegPion   = fTrackCache.NSigmaTPC( nTrack, AliPID::kPion );
+
     //Specific fV0Sel selection level, but no dEdx applied 
      f2dHistInvMassLambda      -> Fill ( lPt , lInvMassLambda     )   ;
     f2dHistInvMassAntiLambda  -> Fill ( lPt , lInvMassAntiLambda )   ;
@@ -607,20 +610,21 @@ void AliAnalysisTaskKzeroshort::UserExec(Option_t *)
   
    if( !(pTrack->GetStatus() & AliESDtrack::kTPCrefit)) continue;
    if( !(nTrack->GetStatus() & AliESDtrack::kTPCrefit)) continue;
-   if ( ( ( pTrack->GetTPCClusterInfo(2,1) ) < 70 ) || ( ( nTrack->GetTPCClusterInfo(2,1) ) < 70 ) ) continue;
+   if ( ( lPosTrackCrossedRows < 70 ) || ( lNegTrackCrossedRows < 70 ) ) continue;
    if (lPt<0.1) continue;
    if (TMath::Abs(v0->Eta()>0.8)) continue;
    if (TMath::Abs(lNegEta) > 0.8) continue;
    if (TMath::Abs(lPosEta) > 0.8) continue;
    if (lDcaPosToPrimVertex < 0.1) continue;
    if (lDcaNegToPrimVertex < 0.1) continue;
-   if (0.497611*v0->DecayLengthV0(lBestPrimaryVtxPos)/(TMath::Sqrt( pow( v0->Px(),2)+ pow( v0->Py(),2) + pow(v0->Pz(),2))) > 30.) continue; 
-   if (TMath::Abs(lNSigmasPosPion) > 6) continue;
-   if (TMath::Abs(lNSigmasNegPion) > 6) continue;
+   if (!AliStrangenessKernels::ProperLifetimeBelow(AliStrangenessKernels::kMassK0Short, AliStrangenessKernels::Distance2(tDecayVertexV0, lBestPrimaryVtxPos), AliStrangenessKernels::Mom2(tV0mom), 30.)) continue; 
    if (lDcaV0Daughters > 1.0) continue;
    if (lV0CosineOfPointingAngle < 0.96) continue; 
    if (lV0Radius < 1.) continue; 
    if (TMath::Abs(lInvMassK0s - 0.497611 ) > 0.03) continue;
+   //PID last: evaluated (or taken from the cache) only for the surviving candidates
+   if (TMath::Abs(fTrackCache.NSigmaTPC( pTrack, AliPID::kPion )) > 6) continue;
+   if (TMath::Abs(fTrackCache.NSigmaTPC( nTrack, AliPID::kPion )) > 6) continue;
 
    fHistInvMassK0ShortAfterSel  -> Fill (  lInvMassK0s        )   ;
   
@@ -650,6 +654,7 @@ void AliAnalysisTaskKzeroshort::Terminate(Option_t *)
       Printf("ERROR - AliAnalysisTaskQAV0 : ouput data container list not available\n");
       return;
    }		
+   AliStrangenessWarningCounter::PrintSummary(GetName(), dynamic_cast<TH1*> (  cRetrievedList->FindObject("fHistWarnings")  ));
    fHistEvent = dynamic_cast<TH1D*> (  cRetrievedList->FindObject("fHistEvent")  );
    if (!fHistEvent) {
       Printf("ERROR - AliAnalysisTaskQAV0 : fHistEvent not available");
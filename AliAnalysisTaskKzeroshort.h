@@ -47,6 +47,8 @@ class AliCFContainer;
 //#include "TString.h"
 //#include "AliESDtrackCuts.h"
 #include "AliAnalysisTaskSE.h"
+#include "AliStrangenessTrackCache.h"
+#include "AliStrangenessWarningCounter.h"
 
 class AliAnalysisTaskKzeroshort : public AliAnalysisTaskSE {
  public:
@@ -127,6 +129,9 @@ class AliAnalysisTaskKzeroshort : public AliAnalysisTaskSE {
 
   //Objects Controlling Task Behaviour 
   AliPIDResponse *fPIDResponse;     // PID response object
+  AliStrangenessTrackCache fTrackCache; //! PID and crossed rows of the daughter tracks of the current event
+  AliStrangenessWarningCounter fWarnings; //! rate-limited warnings, counted in fHistWarnings
+  enum EWarning { kWarnVtxZ, kWarnV0Daughters, kNWarnings };
 
   //Objects Controlling Task Behaviour: has to be streamed! 
   Double_t  fV0Sels[7];           // Array to store the 7 values for the different selections V0 related
@@ -134,7 +139,7 @@ class AliAnalysisTaskKzeroshort : public AliAnalysisTaskSE {
    AliAnalysisTaskKzeroshort(const AliAnalysisTaskKzeroshort&);            // not implemented
    AliAnalysisTaskKzeroshort& operator=(const AliAnalysisTaskKzeroshort&); // not implemented
   
-   ClassDef(AliAnalysisTaskKzeroshort, 11);
+   ClassDef(AliAnalysisTaskKzeroshort, 13);
 };
 
 #endif
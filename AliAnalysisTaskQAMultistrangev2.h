@@ -33,6 +33,9 @@ class AliPIDResponse;
 #include "TString.h"
 
 #include "AliAnalysisTaskSE.h"
+#include "AliStrangenessMCIndex.h"
+#include "AliStrangenessTrackCache.h"
+#include "AliStrangenessWarningCounter.h"
 
 class AliAnalysisTaskQAMultistrangev2 : public AliAnalysisTaskSE {
  public:
@@ -52,6 +55,18 @@ class AliAnalysisTaskQAMultistrangev2 : public AliAnalysisTaskSE {
   void SetMinptCutOnDaughterTracks   (Float_t minptdaughtrks            = 0.    ) { fMinPtCutOnDaughterTracks    = minptdaughtrks;             }
 
  private:
+        // Cascade species and per-species QA variables: the histograms are indexed [species][variable]
+        enum ESpecies { kXiMinus, kXiPlus, kOmegaMinus, kOmegaPlus, kNSpecies };
+        enum EVar2D   { kDcaCascDaught, kDcaBachToPrimVertex, kCascCosineOfPointingAngle, kCascRadius, kInvMassLambdaAsCascDghter,
+                        kDcaV0Daughters, kV0CosineOfPAToCascVertex, kV0Radius, kDcaV0ToPrimVertex, kDcaPosToPrimVertex,
+                        kDcaNegToPrimVertex, kCascProperLength, kV0ProperLength, kNVar2D };
+        enum EVar1D   { kMass, kTransvMomentum, kRapidity, kNVar1D };
+        enum EGenVar  { kGenTotMom, kGenTransvMom, kGenY, kGenEta, kGenTheta, kGenPhi, kNGenVar };
+        // Warning sites of the event and cascade loops, counted in fWarnings
+        enum EWarning { kWarnNoMultSelection, kWarnEvSelCode, kWarnNoPrimVtx, kWarnPosNoTPCrefit, kWarnNegNoTPCrefit, kWarnBachNoTPCrefit,
+                        kWarnBachLowPt, kWarnPosLowPt, kWarnNegLowPt, kWarnCascadeNotFound, kWarnDaughterReused, kWarnDaughterMissing,
+                        kWarnPosLowTPCcls, kWarnNegLowTPCcls, kWarnBachLowTPCcls, kNWarnings };
+
         // Note : In ROOT, "//!" means "do not stream the data from Master node to Worker node" ...
         // your data member object is created on the worker nodes and streaming is not needed.
         // http://root.cern.ch/download/doc/11InputOutput.pdf, page 14
@@ -65,13 +80,13 @@ class AliAnalysisTaskQAMultistrangev2 : public AliAnalysisTaskSE {
         Int_t           fMinnTPCcls;                    // minimum number of TPC cluster for daughter tracks
         Float_t         fMinPtCutOnDaughterTracks;      // minimum pt cut on daughter tracks
         Float_t         fEtaCutOnDaughterTracks;        // pseudorapidity cut on daughter tracks
+        AliStrangenessMCIndex fMCIndex;                 //! MC truth of the current event
+        AliStrangenessTrackCache fTrackCache;           //! TPC PID of the daughter tracks of the current event
+        AliStrangenessWarningCounter fWarnings;         //! rate-limited warnings, counted in fHistWarnings
        
         TList  *fListHistMultistrangeQA;                //! List of Cascade histograms
         TH1F *fHistEventSel;                            //! Gives the number of the events after each event selection
-        TH1F *fHistCascadeMultiplicityXiMinus;          //! Gives the distribution of the number of Xi minus per event
-        TH1F *fHistCascadeMultiplicityXiPlus;           //! Gives the distribution of the number of Xi plus per event
-        TH1F *fHistCascadeMultiplicityOmegaMinus;       //! Gives the distribution of the number of Omega minus per event
-        TH1F *fHistCascadeMultiplicityOmegaPlus;        //! Gives the distribution of the number of Omega plus per event  
+        TH1F *fHistCascadeMultiplicity[kNSpecies];      //! Gives the distribution of the number of generated cascades per event, per species
 
         TH1F *     hCascCosPA; //!
         TH1F *    hCascRadius; //!
@@ -90,103 +105,18 @@ class AliAnalysisTaskQAMultistrangev2 : public AliAnalysisTaskSE {
         TH1F *    hMassOmegaPlus; //!
         TH1F *   hLambdaMass; //!
 
-        TH2F *fHistVarDcaCascDaughtXiMinus;               //!
-        TH2F *fHistVarDcaBachToPrimVertexXiMinus;         //!
-        TH2F *fHistVarCascCosineOfPointingAngleXiMinus;   //!
-        TH2F *fHistVarCascRadiusXiMinus;                  //!
-        TH2F *fHistVarInvMassLambdaAsCascDghterXiMinus;   //!
-        TH2F *fHistVarDcaV0DaughtersXiMinus;              //!
-        TH2F *fHistVarV0CosineOfPAToCascVertexXiMinus;    //!
-        TH2F *fHistVarV0RadiusXiMinus;                    //!
-        TH2F *fHistVarDcaV0ToPrimVertexXiMinus;           //!
-        TH2F *fHistVarDcaPosToPrimVertexXiMinus;          //!
-        TH2F *fHistVarDcaNegToPrimVertexXiMinus;          //!
-        TH1F *fHistMassXiMinus;                           //!
-        TH1F *fHistVarTransvMomentumXiMinus;              //!
-        TH1F *fHistVarRapidityXiMinus;                    //!
-        TH2F *fHistVarCascProperLengthXiMinus;            //!
-        TH2F *fHistVarV0ProperLengthXiMinus;              //!
-        TH1F *fHistGenVarTotMomXiMinus;                   //!
-        TH1F *fHistGenVarTransvMomXiMinus;                //!
-        TH1F *fHistGenVarYXiMinus;                        //! 
-        TH1F *fHistGenVarEtaXiMinus;                      //!
-        TH1F *fHistGenVarThetaXiMinus;                    //!
-        TH1F *fHistGenVarPhiXiMinus;                      //!
- 
-        TH2F *fHistVarDcaCascDaughtXiPlus;                //!
-        TH2F *fHistVarDcaBachToPrimVertexXiPlus;          //!
-        TH2F *fHistVarCascCosineOfPointingAngleXiPlus;    //!
-        TH2F *fHistVarCascRadiusXiPlus;                   //!
-        TH2F *fHistVarInvMassLambdaAsCascDghterXiPlus;    //!
-        TH2F *fHistVarDcaV0DaughtersXiPlus;               //! 
-        TH2F *fHistVarV0CosineOfPAToCascVertexXiPlus;     //!
-        TH2F *fHistVarV0RadiusXiPlus;                     //!
-        TH2F *fHistVarDcaV0ToPrimVertexXiPlus;            //!
-        TH2F *fHistVarDcaPosToPrimVertexXiPlus;           //!
-        TH2F *fHistVarDcaNegToPrimVertexXiPlus;           //!
-        TH1F *fHistMassXiPlus;                            //! 
-        TH1F *fHistVarTransvMomentumXiPlus;               //!
-        TH1F *fHistVarRapidityXiPlus;                     //!
-        TH2F *fHistVarCascProperLengthXiPlus;             //!
-        TH2F *fHistVarV0ProperLengthXiPlus;               //!
-        TH1F *fHistGenVarTotMomXiPlus;                    //!
-        TH1F *fHistGenVarTransvMomXiPlus;                 //!
-        TH1F *fHistGenVarYXiPlus;                         //!
-        TH1F *fHistGenVarEtaXiPlus;                       //!
-        TH1F *fHistGenVarThetaXiPlus;                     //!
-        TH1F *fHistGenVarPhiXiPlus;                       //!
-
-        TH2F *fHistVarDcaCascDaughtOmegaMinus;            //!
-        TH2F *fHistVarDcaBachToPrimVertexOmegaMinus;      //!
-        TH2F *fHistVarCascCosineOfPointingAngleOmegaMinus;//!  
-        TH2F *fHistVarCascRadiusOmegaMinus;               //!
-        TH2F *fHistVarInvMassLambdaAsCascDghterOmegaMinus;//! 
-        TH2F *fHistVarDcaV0DaughtersOmegaMinus;           //!
-        TH2F *fHistVarV0CosineOfPAToCascVertexOmegaMinus; //!
-        TH2F *fHistVarV0RadiusOmegaMinus;                 //!
-        TH2F *fHistVarDcaV0ToPrimVertexOmegaMinus;        //!
-        TH2F *fHistVarDcaPosToPrimVertexOmegaMinus;       //!
-        TH2F *fHistVarDcaNegToPrimVertexOmegaMinus;       //!
-        TH1F *fHistMassOmegaMinus;                        //!
-        TH1F *fHistVarTransvMomentumOmegaMinus;           //!
-        TH1F *fHistVarRapidityOmegaMinus;                 //!
-        TH2F *fHistVarCascProperLengthOmegaMinus;         //!
-        TH2F *fHistVarV0ProperLengthOmegaMinus;           //!
-        TH1F *fHistGenVarTotMomOmegaMinus;                //!
-        TH1F *fHistGenVarTransvMomOmegaMinus;             //!
-        TH1F *fHistGenVarYOmegaMinus;                     //!
-        TH1F *fHistGenVarEtaOmegaMinus;                   //!
-        TH1F *fHistGenVarThetaOmegaMinus;                 //!
-        TH1F *fHistGenVarPhiOmegaMinus;                   //!
- 
-        TH2F *fHistVarDcaCascDaughtOmegaPlus;             //!
-        TH2F *fHistVarDcaBachToPrimVertexOmegaPlus;       //!
-        TH2F *fHistVarCascCosineOfPointingAngleOmegaPlus; //! 
-        TH2F *fHistVarCascRadiusOmegaPlus;                //!
-        TH2F *fHistVarInvMassLambdaAsCascDghterOmegaPlus; //!
-        TH2F *fHistVarDcaV0DaughtersOmegaPlus;            //!
-        TH2F *fHistVarV0CosineOfPAToCascVertexOmegaPlus;  //! 
-        TH2F *fHistVarV0RadiusOmegaPlus;                  //!
-        TH2F *fHistVarDcaV0ToPrimVertexOmegaPlus;         //!
-        TH2F *fHistVarDcaPosToPrimVertexOmegaPlus;        //!
-        TH2F *fHistVarDcaNegToPrimVertexOmegaPlus;        //!
-        TH1F *fHistMassOmegaPlus;                         //!
-        TH1F *fHistVarTransvMomentumOmegaPlus;            //!
-        TH1F *fHistVarRapidityOmegaPlus;                  //!
-        TH2F *fHistVarCascProperLengthOmegaPlus;          //!
-        TH2F *fHistVarV0ProperLengthOmegaPlus;            //!
-        TH1F *fHistGenVarTotMomOmegaPlus;                 //!
-        TH1F *fHistGenVarTransvMomOmegaPlus;              //!
-        TH1F *fHistGenVarYOmegaPlus;                      //!
-        TH1F *fHistGenVarEtaOmegaPlus;                    //!
-        TH1F *fHistGenVarThetaOmegaPlus;                  //!
-        TH1F *fHistGenVarPhiOmegaPlus;                    //! 
+        TH2F *fHistVar2D[kNSpecies][kNVar2D];            //! reconstructed variables vs pT, per species
+        TH1F *fHistVar1D[kNSpecies][kNVar1D];            //! reconstructed mass, pT and rapidity, per species
+        TH1F *fHistGenVar[kNSpecies][kNGenVar];          //! generated kinematics, per species
+
 
+  template <class Traits>
+  void ProcessEvent(typename Traits::Event *lEvent, typename Traits::MCSource *lMCSource); // one event, ESD or AOD traits (AliCascadeFormatTraits.h)
 
   AliAnalysisTaskQAMultistrangev2(const AliAnalysisTaskQAMultistrangev2&);            // not implemented
   AliAnalysisTaskQAMultistrangev2& operator=(const AliAnalysisTaskQAMultistrangev2&); // not implemented
   
-  ClassDef(AliAnalysisTaskQAMultistrangev2, 12);
+  ClassDef(AliAnalysisTaskQAMultistrangev2, 15); //15: warning counters
 };
 
 #endif
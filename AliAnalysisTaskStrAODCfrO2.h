@@ -10,9 +10,19 @@
 #include "AliPIDResponse.h"
 #include "AliAnalysisTaskSE.h"
 #include "THistManager.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
 //#include "AliEventCuts.h"
 #include "AliAnalysisUtils.h"
 #include "AliAODMCHeader.h"
+#include "AliStrangenessMCIndex.h"
+#include "AliStrangenessTrackCache.h"
+#include "AliStrangenessWarningCounter.h"
+#include "AliStrangenessCandidateBatch.h"
+#include "AliStrangenessCandidateTree.h"
+
+class AliAODTrack;
 
 class AliAnalysisTaskStrAODCfrO2 : public AliAnalysisTaskSE {
 public:
@@ -27,6 +37,8 @@ public:
     void SetMC(Bool_t isMC){fReadMCTruth = isMC;}
     void SetOOBPU(Bool_t isOOBPileUpRem){fIsOOBPileUpRem = isOOBPileUpRem;}
     void SetV0Offline(Bool_t isV0Offline){fIsV0Offline = isV0Offline;}
+    void SetMeasureCPUTime(Bool_t measureCPUTime){fMeasureCPUTime = measureCPUTime;}
+    void SetSaveCandidates(Bool_t saveCandidates);
 
     //    AliEventCuts            fEventCuts; //!      
 
@@ -34,6 +46,67 @@ private:
     THistManager* fHistos_eve;   //!
     THistManager* fHistos_V0;   //!
     THistManager* fHistos_Casc;   //!
+    //histograms, resolved once in UserCreateOutputObjects
+    TH1* fHistEve_henum;                        //!
+    TH3* fHistEve_GeneratedParticles;           //!
+
+    TH1* fHistV0_CosPA;                         //!
+    TH1* fHistV0_Radius;                        //!
+    TH1* fHistV0_DecayLength;                   //!
+    TH1* fHistV0_V0DCANegToPV;                  //!
+    TH1* fHistV0_V0DCAPosToPV;                  //!
+    TH1* fHistV0_V0DCAV0Daughters;              //!
+    TH1* fHistV0_CtauK0s;                       //!
+    TH1* fHistV0_CtauLambda;                    //!
+    TH1* fHistV0_CtauAntiLambda;                //!
+    TH1* fHistV0_DecayLengthK0s;                //!
+    TH1* fHistV0_DecayLengthLambda;             //!
+    TH1* fHistV0_DecayLengthAntiLambda;         //!
+    TH2* fHistV0_ResponsePionFromLambda;        //!
+    TH2* fHistV0_ResponseProtonFromLambda;      //!
+    TH1* fHistV0_ImassK0SBefSel1D;              //!
+    TH2* fHistV0_ImassK0SBefSel;                //!
+    TH1* fHistV0_ImassK0S1D;                    //!
+    TH2* fHistV0_ImassK0S;                      //!
+    TH2* fHistV0_ImassLam;                      //!
+    TH2* fHistV0_ImassALam;                     //!
+    TH2* fHistV0_ImassLam_Ctau;                 //!
+    TH2* fHistV0_ImassALam_Ctau;                //!
+    TH2* fHistV0_ImassK0STrue;                  //!
+    TH2* fHistV0_ImassLamTrue;                  //!
+    TH2* fHistV0_ImassALamTrue;                 //!
+
+    TH2* fHistCasc_XiProgSelections;            //!
+    TH2* fHistCasc_OmegaProgSelections;         //!
+    TH2* fHistCasc_CascCosPA;                   //!
+    TH2* fHistCasc_V0CosPA;                     //!
+    TH2* fHistCasc_V0CosPAToXi;                 //!
+    TH2* fHistCasc_CascDecayLength;             //!
+    TH2* fHistCasc_CascDecayLengthXi;           //!
+    TH2* fHistCasc_CascDecayLengthOmega;        //!
+    TH2* fHistCasc_CascRadius;                  //!
+    TH2* fHistCasc_V0Radius;                    //!
+    TH2* fHistCasc_CascyXi;                     //!
+    TH2* fHistCasc_CascyOmega;                  //!
+    TH2* fHistCasc_CascCtauXi;                  //!
+    TH2* fHistCasc_CascCtauOmega;               //!
+    TH2* fHistCasc_V0Ctau;                      //!
+    TH2* fHistCasc_CascPt;                      //!
+    TH2* fHistCasc_DcaV0Daughters;              //!
+    TH2* fHistCasc_DcaCascDaughters;            //!
+    TH2* fHistCasc_DcaV0ToPV;                   //!
+    TH2* fHistCasc_DcaBachToPV;                 //!
+    TH2* fHistCasc_DcaPosToPV;                  //!
+    TH2* fHistCasc_DcaNegToPV;                  //!
+    TH2* fHistCasc_InvMassLambdaDaughter;       //!
+    TH2* fHistCasc_ImassXiPlu;                  //!
+    TH2* fHistCasc_ImassXiMin;                  //!
+    TH2* fHistCasc_ImassOmPlu;                  //!
+    TH2* fHistCasc_ImassOmMin;                  //!
+    TH2* fHistCasc_ImassXiPluTrue;              //!
+    TH2* fHistCasc_ImassXiMinTrue;              //!
+    TH2* fHistCasc_ImassOmPluTrue;              //!
+    TH2* fHistCasc_ImassOmMinTrue;              //!
 
     //objects retreived from input handler
     AliPIDResponse *fPIDResponse;     //! PID response object
@@ -41,95 +114,51 @@ private:
 
     //variables for MC analysis
     AliMCEvent *            fMCEvent;         //!                                                                                        
+    AliStrangenessMCIndex   fMCIndex;         //! MC truth of the current event
+    AliStrangenessTrackCache fTrackCache;     //! PID, crossed rows and TOF BC of the daughter tracks of the current event
+    AliStrangenessWarningCounter fWarnings;   //! rate-limited warnings, counted in the "Warnings" event histogram
+    enum EWarning { kWarnNoPrimVtx, kWarnNoMCHeader, kWarnV0Daughters, kWarnCascDaughters, kNWarnings };
     Bool_t                  fReadMCTruth;
     Bool_t                  fIsOOBPileUpRem;
     Bool_t                  fIsV0Offline;
+    Bool_t                  fMeasureCPUTime;
+    TH1*                    fHistEve_CPUTime;  //!
+
+    //candidates of the current event, filled by the V0 and cascade loops and selected as a whole
+    AliV0CandidateBatch     fV0Batch;   //!
+    AliCascCandidateBatch   fCascBatch; //!
+    AliV0Cuts               fV0Cuts;    //! analysis selections
+    AliCascCuts             fCascCuts;  //! analysis selections
 
-    //variables for V0 analysis
-    double fV0_DcaV0Daught;  //!
-    double fV0_DcaPosToPV;   //!
-    double fV0_DcaNegToPV;   //!
-    double fV0_V0CosPA;      //!
-    double fV0_V0Rad;        //!
-    double fV0_Pt;           //!
-    double fV0_yK0S;         //!
-    double fV0_yLam;         //!
-    double fV0_etaPos;       //!
-    double fV0_etaNeg;       //!
-    double fV0_InvMassK0s;   //!
-    double fV0_InvMassLam;   //!
-    double fV0_InvMassALam;  //!
-    double fV0_LeastCRaws;   //!
-    double fV0_LeastCRawsOvF;//!
-    double fV0_NSigPosProton;//!
-    double fV0_NSigPosPion;  //!
-    double fV0_NSigNegProton;//!
-    double fV0_NSigNegPion;  //!
-    double fV0_NegTOFBunchCrossing; //!
-    double fV0_PosTOFBunchCrossing; //!
-    double fIsV0FromOOBPileUp;      //!
-    double fV0_DistOverTotP; //!
-    double fV0_DecayLength;  //!
-    double fV0_CtauK0s;      //!
-    double fV0_CtauLambda;   //!
-
-    //variables for Cascade analysis
-    bool   fCasc_isNotTPCRefit;      //!
-    double fCasc_DcaCascDaught;      //!
-    double fCasc_CascCosPA;          //!
-    double fCasc_CascRad;            //!
-    double fCasc_etaPos;             //!
-    double fCasc_etaNeg;             //!
-    double fCasc_etaBac;             //!
-    double fCasc_kinkidx;            //!
-    double fCasc_NSigPosProton;      //!
-    double fCasc_NSigPosPion;        //!
-    double fCasc_NSigNegProton;      //!
-    double fCasc_NSigNegPion;        //!
-    double fCasc_NSigBacPion;        //!
-    double fCasc_NSigBacKaon;        //!
-    double fCasc_LeastCRaws;         //!
-    double fCasc_LeastCRawsOvF;      //!
-    double fCasc_DcaV0Daught;        //!
-    double fCasc_V0CosPA;            //!
-    double fCasc_V0CosPAToXi;        //!
-    double fCasc_DcaV0ToPV;          //!
-    double fCasc_DcaBachToPV;        //!
-    double fCasc_yXi;                //!
-    double fCasc_yOm;                //!
-    int    fCasc_charge;             //!
-    double fCasc_Pt;                 //!
-    double fCasc_Ptot;               //!
-    double fCasc_NegTOFBunchCrossing; //!
-    double fCasc_PosTOFBunchCrossing; //!
-    double fCasc_BachTOFBunchCrossing;//!
-    double fIsCascFromOOBPileUp;     //!
-    double fCasc_DistOverTotP;       //!
-    double fCasc_DecayLength;        //!
-    double fCasc_V0DistOverTotP;     //!
-    double fCasc_CascCtauXi;         //!
-    double fCasc_CascCtauOmega;      //!
-    double fCasc_V0Ctau;             //!
-    double fCasc_InvMassXi;          //!
-    double fCasc_InvMassOm;          //!
-    double fCasc_V0Rad;              //!
-    double fCasc_DcaPosToPV;         //!
-    double fCasc_DcaNegToPV;         //!
-    double fCasc_InvMassLambda;      //!
+    //candidate ntuples for the offline cut optimisation (ReapplyCutsStrAODCfrO2.C)
+    Bool_t                  fSaveCandidates;
+    AliV0CandidateTree      fV0Tree;    //!
+    AliCascCandidateTree    fCascTree;  //!
 
     //list of analysed particles
     //    static const int kNParticles = 7;
     //    const char *kParticleNames[kNParticles]= {"K0s", "Lambda", "anti-Lambda", "Xi-", "Xi+", "Om-", "Om+"}; 
 
-    //cuts application
-    bool ApplyCuts(int, bool, bool);
-    bool ApplyCutsNSigmaTPC(int);
+    //cuts application: masks of the hypotheses passing the selections (see AliStrangenessCandidateBatch.h)
+    enum { kK0sBit = AliStrangenessSelection::kK0sBit, kLambdaBit = AliStrangenessSelection::kLambdaBit, kAntiLambdaBit = AliStrangenessSelection::kAntiLambdaBit };
+    enum { kXiPluBit = AliStrangenessSelection::kXiPluBit, kXiMinBit = AliStrangenessSelection::kXiMinBit, kOmPluBit = AliStrangenessSelection::kOmPluBit, kOmMinBit = AliStrangenessSelection::kOmMinBit };
+    Bool_t IsFromOOBPileUp(const AliAODTrack *pTrack, const AliAODTrack *nTrack, const AliAODTrack *bTrack = 0x0);
+    void FillV0Histograms();
+    void FillCascadeHistograms();
+    void FillV0PID(Int_t i);
+    void FillCascadePID(Int_t i);
+    void SaveCandidates();
 
     AliAnalysisTaskStrAODCfrO2(const AliAnalysisTaskStrAODCfrO2&);            // not implemented
     AliAnalysisTaskStrAODCfrO2& operator=(const AliAnalysisTaskStrAODCfrO2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrAODCfrO2, 1);
+    ClassDef(AliAnalysisTaskStrAODCfrO2, 6);
     //1: first implementation
+    //2: histogram pointers cached, CPU time monitoring
+    //3: daughter-track PID, crossed rows and TOF BC cached per event and evaluated lazily
+    //4: per-event candidate batches replace the per-candidate data members
+    //5: optional candidate ntuples
+    //6: warning counters
 };
 
 #endif
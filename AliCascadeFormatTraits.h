@@ -0,0 +1,144 @@
+/// \file AliCascadeFormatTraits.h
+/// \brief ESD and AOD traits for the cascade and generated-particle loops of AliAnalysisTaskQAMultistrangev2.
+///
+/// Each traits class names the event, cascade, track and MC types of one input format and wraps
+/// the few accessors whose name or definition differs between AliESDcascade and AliAODcascade.
+/// The loops are written once as templates over the traits and the format is chosen once per event.
+/// The invariant masses are not part of the traits: they come from the daughter momenta through
+/// AliStrangenessKernels.h, identically for both formats.
+
+#ifndef AliCascadeFormatTraits_H
+#define AliCascadeFormatTraits_H
+
+#include "TMath.h"
+#include "TClonesArray.h"
+#include "TParticle.h"
+#include "AliMCEvent.h"
+#include "AliAODMCParticle.h"
+#include "AliESDEvent.h"
+#include "AliESDcascade.h"
+#include "AliESDtrack.h"
+#include "AliAODEvent.h"
+#include "AliAODcascade.h"
+#include "AliAODTrack.h"
+
+/// Outcome of GetDaughters, counted by the task in its warning histogram
+enum EAliCascadeDaughters { kCascDaughtersFound, kCascDaughterReused, kCascDaughterMissing };
+
+struct AliESDCascadeTraits {
+  typedef AliESDEvent   Event;
+  typedef AliESDcascade Cascade;
+  typedef AliESDtrack   Track;
+  typedef AliMCEvent    MCSource;
+  typedef TParticle     MCParticle;
+
+  static const char* Name() { return "ESD"; }
+
+  //generated particles
+  static Int_t GetNumberOfParticles(MCSource *mc) { return mc->GetNumberOfTracks(); }
+  static MCParticle* GetParticle(MCSource *mc, Int_t i) { return mc->Particle(i); }
+  static Double_t Energy(const MCParticle *particle) { return particle->Energy(); }
+
+  //cascade topology
+  static Cascade* GetCascade(Event *event, Int_t i) { return event->GetCascade(i); }
+  static Short_t Charge(Cascade *xi) { return xi->Charge(); }
+  static Double_t DcaXiDaughters(Cascade *xi) { return xi->GetDcaXiDaughters(); }
+  static Double_t CascCosPA(Cascade *xi, Double_t *pv) { return xi->GetCascadeCosineOfPointingAngle(pv[0], pv[1], pv[2]); }
+  static void CascadeVertex(Cascade *xi, Double_t *pos) { xi->GetXYZcascade(pos[0], pos[1], pos[2]); }
+  static void V0Vertex(Cascade *xi, Double_t *pos) { xi->GetXYZ(pos[0], pos[1], pos[2]); }
+  static Double_t DcaV0Daughters(Cascade *xi) { return xi->GetDcaV0Daughters(); }
+  static Double_t V0CosPA(Cascade *xi, Double_t *pv) { return xi->GetV0CosineOfPointingAngle(pv[0], pv[1], pv[2]); }
+  static Double_t V0CosPAToXi(Cascade *xi, Double_t *posXi) { return xi->GetV0CosineOfPointingAngle(posXi[0], posXi[1], posXi[2]); }
+  static Double_t DcaV0ToPV(Cascade *xi, Double_t *pv) { return xi->GetD(pv[0], pv[1], pv[2]); }
+  static Double_t DcaBachToPV(Cascade *, Track *bTrack, Double_t *pv, Double_t bField) { return TMath::Abs(bTrack->GetD(pv[0], pv[1], bField)); }
+  static Double_t DcaPosToPV(Cascade *, Track *pTrack, Double_t *pv, Double_t bField) { return TMath::Abs(pTrack->GetD(pv[0], pv[1], bField)); }
+  static Double_t DcaNegToPV(Cascade *, Track *nTrack, Double_t *pv, Double_t bField) { return TMath::Abs(nTrack->GetD(pv[0], pv[1], bField)); }
+
+  /// daughters from the track indices; kCascDaughterReused if the bachelor index equals a V0 daughter index
+  /// (checked first), else kCascDaughterMissing if a track is not found, else kCascDaughtersFound
+  static EAliCascadeDaughters GetDaughters(Event *event, Cascade *xi, Track *&pTrack, Track *&nTrack, Track *&bTrack)
+  {
+    UInt_t lIdxPosXi = (UInt_t) TMath::Abs( xi->GetPindex() );
+    UInt_t lIdxNegXi = (UInt_t) TMath::Abs( xi->GetNindex() );
+    UInt_t lBachIdx  = (UInt_t) TMath::Abs( xi->GetBindex() );
+    if (lBachIdx == lIdxNegXi || lBachIdx == lIdxPosXi) return kCascDaughterReused;
+    pTrack = event->GetTrack( lIdxPosXi );
+    nTrack = event->GetTrack( lIdxNegXi );
+    bTrack = event->GetTrack( lBachIdx );
+    return (pTrack && nTrack && bTrack) ? kCascDaughtersFound : kCascDaughterMissing;
+  }
+  static Bool_t HasTPCrefit(Track *track) { return (track->GetStatus() & AliESDtrack::kTPCrefit) != 0; }
+
+  //momenta
+  static void Momenta(Cascade *xi, Double_t *xiMom, Double_t *posMom, Double_t *negMom, Double_t *bachMom)
+  {
+    xi->GetPxPyPz(xiMom[0], xiMom[1], xiMom[2]);
+    xi->GetNPxPyPz(negMom[0], negMom[1], negMom[2]);
+    xi->GetPPxPyPz(posMom[0], posMom[1], posMom[2]);
+    xi->GetBPxPyPz(bachMom[0], bachMom[1], bachMom[2]);
+  }
+  static Double_t V0TotalMomentum(Cascade *, const Double_t *posMom, const Double_t *negMom)
+  {
+    return TMath::Sqrt(TMath::Power(negMom[0]+posMom[0],2)+TMath::Power(negMom[1]+posMom[1],2)+TMath::Power(negMom[2]+posMom[2],2));
+  }
+};
+
+struct AliAODCascadeTraits {
+  typedef AliAODEvent      Event;
+  typedef AliAODcascade    Cascade;
+  typedef AliAODTrack      Track;
+  typedef TClonesArray     MCSource;
+  typedef AliAODMCParticle MCParticle;
+
+  static const char* Name() { return "AOD"; }
+
+  //generated particles
+  static Int_t GetNumberOfParticles(MCSource *mc) { return mc->GetEntries(); }
+  static MCParticle* GetParticle(MCSource *mc, Int_t i) { return (AliAODMCParticle*) mc->At(i); }
+  static Double_t Energy(const MCParticle *particle) { return particle->E(); }
+
+  //cascade topology
+  static Cascade* GetCascade(Event *event, Int_t i) { return event->GetCascade(i); }
+  static Short_t Charge(Cascade *xi) { return xi->ChargeXi(); }
+  static Double_t DcaXiDaughters(Cascade *xi) { return xi->DcaXiDaughters(); }
+  static Double_t CascCosPA(Cascade *xi, Double_t *pv) { return xi->CosPointingAngleXi(pv[0], pv[1], pv[2]); }
+  static void CascadeVertex(Cascade *xi, Double_t *pos) { pos[0] = xi->DecayVertexXiX(); pos[1] = xi->DecayVertexXiY(); pos[2] = xi->DecayVertexXiZ(); }
+  static void V0Vertex(Cascade *xi, Double_t *pos) { pos[0] = xi->DecayVertexV0X(); pos[1] = xi->DecayVertexV0Y(); pos[2] = xi->DecayVertexV0Z(); }
+  static Double_t DcaV0Daughters(Cascade *xi) { return xi->DcaV0Daughters(); }
+  static Double_t V0CosPA(Cascade *xi, Double_t *pv) { return xi->CosPointingAngle(pv); }
+  static Double_t V0CosPAToXi(Cascade *xi, Double_t *) { return xi->CosPointingAngle(xi->GetDecayVertexXi()); }
+  static Double_t DcaV0ToPV(Cascade *xi, Double_t *) { return xi->DcaV0ToPrimVertex(); }
+  static Double_t DcaBachToPV(Cascade *xi, Track *, Double_t *, Double_t) { return xi->DcaBachToPrimVertex(); }
+  static Double_t DcaPosToPV(Cascade *xi, Track *, Double_t *, Double_t) { return xi->DcaPosToPrimVertex(); }
+  static Double_t DcaNegToPV(Cascade *xi, Track *, Double_t *, Double_t) { return xi->DcaNegToPrimVertex(); }
+
+  /// daughters from the secondary vertices; kCascDaughterMissing if a track is not found (checked first),
+  /// else kCascDaughterReused if the bachelor ID equals a V0 daughter ID, else kCascDaughtersFound
+  static EAliCascadeDaughters GetDaughters(Event *, Cascade *xi, Track *&pTrack, Track *&nTrack, Track *&bTrack)
+  {
+    pTrack = dynamic_cast<AliAODTrack*>( xi->GetDaughter(0) );
+    nTrack = dynamic_cast<AliAODTrack*>( xi->GetDaughter(1) );
+    bTrack = dynamic_cast<AliAODTrack*>( xi->GetDecayVertexXi()->GetDaughter(0) );
+    if (!pTrack || !nTrack || !bTrack) return kCascDaughterMissing;
+    UInt_t lIdxPosXi = (UInt_t) TMath::Abs( pTrack->GetID() );
+    UInt_t lIdxNegXi = (UInt_t) TMath::Abs( nTrack->GetID() );
+    UInt_t lBachIdx  = (UInt_t) TMath::Abs( bTrack->GetID() );
+    return (lBachIdx != lIdxNegXi && lBachIdx != lIdxPosXi) ? kCascDaughtersFound : kCascDaughterReused;
+  }
+  static Bool_t HasTPCrefit(Track *track) { return track->IsOn(AliAODTrack::kTPCrefit); }
+
+  //momenta
+  static void Momenta(Cascade *xi, Double_t *xiMom, Double_t *posMom, Double_t *negMom, Double_t *bachMom)
+  {
+    xiMom[0] = xi->MomXiX(); xiMom[1] = xi->MomXiY(); xiMom[2] = xi->MomXiZ();
+    posMom[0] = xi->MomPosX(); posMom[1] = xi->MomPosY(); posMom[2] = xi->MomPosZ();
+    negMom[0] = xi->MomNegX(); negMom[1] = xi->MomNegY(); negMom[2] = xi->MomNegZ();
+    bachMom[0] = xi->MomBachX(); bachMom[1] = xi->MomBachY(); bachMom[2] = xi->MomBachZ();
+  }
+  static Double_t V0TotalMomentum(Cascade *xi, const Double_t *, const Double_t *)
+  {
+    return TMath::Sqrt(TMath::Power(xi->MomV0X(),2)+TMath::Power(xi->MomV0Y(),2)+TMath::Power(xi->MomV0Z(),2));
+  }
+};
+
+#endif
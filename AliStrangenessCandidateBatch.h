@@ -0,0 +1,397 @@
+/// \file AliStrangenessCandidateBatch.h
+/// \brief Per-event struct-of-arrays batches of V0 and cascade candidates and the selections applied on them.
+///
+/// The candidate loops only fill the batches; the selections are static functions that read the
+/// variables of candidate i and write its hypothesis mask (and, for cascades, the last selection
+/// step passed by each hypothesis), so that contiguous ranges of candidates can be evaluated in
+/// vectorised loops or handed to different threads. The variables are stored in double precision,
+/// as returned by the AliAODv0/AliAODcascade accessors, and the cut values are doubles, so that
+/// the selections give the same decisions as the candidate-by-candidate cuts they replace.
+/// The cut values are taken from AliV0Cuts and AliCascCuts: the default-constructed sets are the
+/// analysis selections, Loose() gives the preselection used for the candidate ntuple.
+/// The selections run in stages, so that the daughter-track PID and the out-of-bunch pile-up
+/// flag are only filled for the candidates surviving the topological cuts:
+///  - V0:      SelectV0Topology -> (pile-up flag) -> SelectV0PileUp -> (PID) -> SelectV0PID
+///  - cascade: SelectCascTopology -> (pile-up flag) -> SelectCascPileUpAndMass -> (PID) -> SelectCascPID
+
+#ifndef AliStrangenessCandidateBatch_H
+#define AliStrangenessCandidateBatch_H
+
+#include <vector>
+#include <cmath>
+#include "Rtypes.h"
+
+class AliAODTrack;
+
+struct AliV0CandidateBatch {
+  //kinematics and topology
+  std::vector<Double_t> fPt;
+  std::vector<Double_t> fYK0s;
+  std::vector<Double_t> fYLam;
+  std::vector<Double_t> fEtaPos;
+  std::vector<Double_t> fEtaNeg;
+  std::vector<Double_t> fLeastCRows;       // lowest number of TPC crossed rows of the daughters
+  std::vector<Double_t> fLeastCRowsOvF;    // lowest crossed rows over findable clusters of the daughters
+  std::vector<Double_t> fDcaPosToPV;
+  std::vector<Double_t> fDcaNegToPV;
+  std::vector<Double_t> fDcaV0Daught;
+  std::vector<Double_t> fV0Rad;
+  std::vector<Double_t> fV0CosPA;
+  std::vector<Double_t> fDecayLength;
+  std::vector<Double_t> fDistOverTotP;
+  std::vector<Double_t> fInvMassK0s;
+  std::vector<Double_t> fInvMassLam;
+  std::vector<Double_t> fInvMassALam;
+  //filled only for the candidates passing the topological selections
+  std::vector<UChar_t> fIsOOBPileUp;
+  std::vector<Double_t> fNSigPosProton;
+  std::vector<Double_t> fNSigPosPion;
+  std::vector<Double_t> fNSigNegProton;
+  std::vector<Double_t> fNSigNegPion;
+  //daughters and MC truth (same bits as the hypothesis mask)
+  std::vector<const AliAODTrack*> fPosTrack;
+  std::vector<const AliAODTrack*> fNegTrack;
+  std::vector<UInt_t>  fMCTrue;
+  //selection output
+  std::vector<UInt_t>  fHypMask;
+
+  Int_t Size() const { return fPt.size(); }
+
+  void Clear()
+  {
+    fPt.clear(); fYK0s.clear(); fYLam.clear(); fEtaPos.clear(); fEtaNeg.clear();
+    fLeastCRows.clear(); fLeastCRowsOvF.clear(); fDcaPosToPV.clear(); fDcaNegToPV.clear();
+    fDcaV0Daught.clear(); fV0Rad.clear(); fV0CosPA.clear(); fDecayLength.clear(); fDistOverTotP.clear();
+    fInvMassK0s.clear(); fInvMassLam.clear(); fInvMassALam.clear();
+    fIsOOBPileUp.clear(); fNSigPosProton.clear(); fNSigPosPion.clear(); fNSigNegProton.clear(); fNSigNegPion.clear();
+    fPosTrack.clear(); fNegTrack.clear(); fMCTrue.clear(); fHypMask.clear();
+  }
+
+  /// append a candidate with the lazily filled variables and the selection output zeroed
+  Int_t Add()
+  {
+    fPt.push_back(0); fYK0s.push_back(0); fYLam.push_back(0); fEtaPos.push_back(0); fEtaNeg.push_back(0);
+    fLeastCRows.push_back(0); fLeastCRowsOvF.push_back(0); fDcaPosToPV.push_back(0); fDcaNegToPV.push_back(0);
+    fDcaV0Daught.push_back(0); fV0Rad.push_back(0); fV0CosPA.push_back(0); fDecayLength.push_back(0); fDistOverTotP.push_back(0);
+    fInvMassK0s.push_back(0); fInvMassLam.push_back(0); fInvMassALam.push_back(0);
+    fIsOOBPileUp.push_back(0); fNSigPosProton.push_back(0); fNSigPosPion.push_back(0); fNSigNegProton.push_back(0); fNSigNegPion.push_back(0);
+    fPosTrack.push_back(0x0); fNegTrack.push_back(0x0); fMCTrue.push_back(0); fHypMask.push_back(0);
+    return Size() - 1;
+  }
+};
+
+struct AliCascCandidateBatch {
+  enum { kNHyp = 4 };
+  //kinematics and topology
+  std::vector<Int_t>   fCharge;
+  std::vector<UChar_t> fIsNotTPCRefit;
+  std::vector<Double_t> fPt;
+  std::vector<Double_t> fYXi;
+  std::vector<Double_t> fYOm;
+  std::vector<Double_t> fEtaPos;
+  std::vector<Double_t> fEtaNeg;
+  std::vector<Double_t> fEtaBac;
+  std::vector<Double_t> fLeastCRows;
+  std::vector<Double_t> fLeastCRowsOvF;
+  std::vector<Double_t> fCascRad;
+  std::vector<Double_t> fV0Rad;
+  std::vector<Double_t> fCascCosPA;
+  std::vector<Double_t> fV0CosPA;
+  std::vector<Double_t> fV0CosPAToXi;
+  std::vector<Double_t> fDcaBachToPV;
+  std::vector<Double_t> fDcaV0ToPV;
+  std::vector<Double_t> fDcaPosToPV;
+  std::vector<Double_t> fDcaNegToPV;
+  std::vector<Double_t> fDcaV0Daught;
+  std::vector<Double_t> fDcaCascDaught;
+  std::vector<Double_t> fDecayLength;
+  std::vector<Double_t> fDistOverTotP;
+  std::vector<Double_t> fV0DistOverTotP;
+  std::vector<Double_t> fInvMassLambda;    // mass of the V0 daughter (Lambda or anti-Lambda according to the charge)
+  std::vector<Double_t> fInvMassXi;
+  std::vector<Double_t> fInvMassOm;
+  //filled only for the candidates passing the topological selections
+  std::vector<UChar_t> fIsOOBPileUp;
+  std::vector<Double_t> fNSigPosProton;
+  std::vector<Double_t> fNSigPosPion;
+  std::vector<Double_t> fNSigNegProton;
+  std::vector<Double_t> fNSigNegPion;
+  std::vector<Double_t> fNSigBacPion;
+  std::vector<Double_t> fNSigBacKaon;
+  //daughters and MC truth (same bits as the hypothesis mask)
+  std::vector<const AliAODTrack*> fPosTrack;
+  std::vector<const AliAODTrack*> fNegTrack;
+  std::vector<const AliAODTrack*> fBacTrack;
+  std::vector<UInt_t>  fMCTrue;
+  //selection output: hypothesis mask and, per hypothesis, the last selection step passed
+  std::vector<UInt_t>  fHypMask;
+  std::vector<Int_t>   fLastStep;          // kNHyp entries per candidate
+
+  Int_t Size() const { return fPt.size(); }
+  Int_t* LastStep(Int_t i) { return &fLastStep[kNHyp * i]; }
+  const Int_t* LastStep(Int_t i) const { return &fLastStep[kNHyp * i]; }
+
+  void Clear()
+  {
+    fCharge.clear(); fIsNotTPCRefit.clear(); fPt.clear(); fYXi.clear(); fYOm.clear();
+    fEtaPos.clear(); fEtaNeg.clear(); fEtaBac.clear(); fLeastCRows.clear(); fLeastCRowsOvF.clear();
+    fCascRad.clear(); fV0Rad.clear(); fCascCosPA.clear(); fV0CosPA.clear(); fV0CosPAToXi.clear();
+    fDcaBachToPV.clear(); fDcaV0ToPV.clear(); fDcaPosToPV.clear(); fDcaNegToPV.clear(); fDcaV0Daught.clear(); fDcaCascDaught.clear();
+    fDecayLength.clear(); fDistOverTotP.clear(); fV0DistOverTotP.clear(); fInvMassLambda.clear(); fInvMassXi.clear(); fInvMassOm.clear();
+    fIsOOBPileUp.clear(); fNSigPosProton.clear(); fNSigPosPion.clear(); fNSigNegProton.clear(); fNSigNegPion.clear(); fNSigBacPion.clear(); fNSigBacKaon.clear();
+    fPosTrack.clear(); fNegTrack.clear(); fBacTrack.clear(); fMCTrue.clear(); fHypMask.clear(); fLastStep.clear();
+  }
+
+  /// append a candidate with the lazily filled variables and the selection output zeroed
+  Int_t Add()
+  {
+    fCharge.push_back(0); fIsNotTPCRefit.push_back(0); fPt.push_back(0); fYXi.push_back(0); fYOm.push_back(0);
+    fEtaPos.push_back(0); fEtaNeg.push_back(0); fEtaBac.push_back(0); fLeastCRows.push_back(0); fLeastCRowsOvF.push_back(0);
+    fCascRad.push_back(0); fV0Rad.push_back(0); fCascCosPA.push_back(0); fV0CosPA.push_back(0); fV0CosPAToXi.push_back(0);
+    fDcaBachToPV.push_back(0); fDcaV0ToPV.push_back(0); fDcaPosToPV.push_back(0); fDcaNegToPV.push_back(0); fDcaV0Daught.push_back(0); fDcaCascDaught.push_back(0);
+    fDecayLength.push_back(0); fDistOverTotP.push_back(0); fV0DistOverTotP.push_back(0); fInvMassLambda.push_back(0); fInvMassXi.push_back(0); fInvMassOm.push_back(0);
+    fIsOOBPileUp.push_back(0); fNSigPosProton.push_back(0); fNSigPosPion.push_back(0); fNSigNegProton.push_back(0); fNSigNegPion.push_back(0); fNSigBacPion.push_back(0); fNSigBacKaon.push_back(0);
+    fPosTrack.push_back(0x0); fNegTrack.push_back(0x0); fBacTrack.push_back(0x0); fMCTrue.push_back(0); fHypMask.push_back(0);
+    fLastStep.insert(fLastStep.end(), kNHyp, 0);
+    return Size() - 1;
+  }
+};
+
+struct AliV0Cuts {
+  Double_t fMaxRapidity;          // |y|, for each hypothesis
+  Double_t fMaxDaughterEta;
+  Double_t fMinCrossedRows;
+  Double_t fMinCrossedRowsOvF;
+  Double_t fMinDcaDaughToPV;
+  Double_t fMaxDcaV0Daught;
+  Double_t fMinV0Radius;
+  Double_t fMinV0CosPA;
+  Double_t fMaxCtauK0s;
+  Double_t fMaxCtauLambda;
+  Double_t fK0sLambdaRejection;   // the K0s hypothesis is rejected if |mass(Lambda)| is below this value
+  Double_t fMaxNSigmaTPC;
+
+  AliV0Cuts() :
+    fMaxRapidity(0.5), fMaxDaughterEta(0.8), fMinCrossedRows(70), fMinCrossedRowsOvF(0.8),
+    fMinDcaDaughToPV(0.1), fMaxDcaV0Daught(0.5), fMinV0Radius(3.0), fMinV0CosPA(0.998),
+    fMaxCtauK0s(20), fMaxCtauLambda(30), fK0sLambdaRejection(0.005), fMaxNSigmaTPC(3) {}
+
+  /// preselection of the candidate ntuple: looser than the default set in every variable
+  static AliV0Cuts Loose()
+  {
+    AliV0Cuts cuts;
+    cuts.fMaxRapidity = 0.8; cuts.fMaxDaughterEta = 0.9; cuts.fMinCrossedRows = 50; cuts.fMinCrossedRowsOvF = 0.7;
+    cuts.fMinDcaDaughToPV = 0.05; cuts.fMaxDcaV0Daught = 1.0; cuts.fMinV0Radius = 1.0; cuts.fMinV0CosPA = 0.99;
+    cuts.fMaxCtauK0s = 40; cuts.fMaxCtauLambda = 60; cuts.fK0sLambdaRejection = 0; cuts.fMaxNSigmaTPC = 5;
+    return cuts;
+  }
+};
+
+struct AliCascCuts {
+  Double_t fMaxRapidity;          // |y|, for each hypothesis
+  Double_t fMaxDaughterEta;
+  Double_t fMinCrossedRows;
+  Double_t fMinCrossedRowsOvF;
+  Double_t fMinCascRadius;
+  Double_t fMinV0Radius;
+  Double_t fMinCascCosPA;
+  Double_t fMinV0CosPAToXi;
+  Double_t fMinDcaBachToPV;
+  Double_t fMinDcaV0ToPV;
+  Double_t fMinDcaMesonToPV;      // V0 daughters: pion
+  Double_t fMinDcaBaryonToPV;     // V0 daughters: (anti-)proton
+  Double_t fMaxDcaV0Daught;
+  Double_t fMaxDcaCascDaught;
+  Double_t fLambdaMassWindow;
+  Double_t fXiRejectionWindow;    // the Omega hypotheses are rejected if |mass(Xi)-m_Xi| is below this value
+  Double_t fMaxCtauXi;
+  Double_t fMaxCtauOmega;
+  Double_t fMaxNSigmaTPC;
+
+  AliCascCuts() :
+    fMaxRapidity(0.5), fMaxDaughterEta(0.8), fMinCrossedRows(70), fMinCrossedRowsOvF(0.8),
+    fMinCascRadius(1.0), fMinV0Radius(5.0), fMinCascCosPA(0.9992), fMinV0CosPAToXi(0.99),
+    fMinDcaBachToPV(0.17), fMinDcaV0ToPV(0.15), fMinDcaMesonToPV(0.3), fMinDcaBaryonToPV(0.11),
+    fMaxDcaV0Daught(1.), fMaxDcaCascDaught(0.3), fLambdaMassWindow(0.005), fXiRejectionWindow(0.003),
+    fMaxCtauXi(4.91*3), fMaxCtauOmega(2.461*3), fMaxNSigmaTPC(3) {}  //4.91 and 2.461 are the ctau of xi and om in cm
+
+  /// preselection of the candidate ntuple: looser than the default set in every variable
+  static AliCascCuts Loose()
+  {
+    AliCascCuts cuts;
+    cuts.fMaxRapidity = 0.8; cuts.fMaxDaughterEta = 0.9; cuts.fMinCrossedRows = 50; cuts.fMinCrossedRowsOvF = 0.7;
+    cuts.fMinCascRadius = 0.5; cuts.fMinV0Radius = 2.0; cuts.fMinCascCosPA = 0.99; cuts.fMinV0CosPAToXi = 0.97;
+    cuts.fMinDcaBachToPV = 0.05; cuts.fMinDcaV0ToPV = 0.05; cuts.fMinDcaMesonToPV = 0.1; cuts.fMinDcaBaryonToPV = 0.05;
+    cuts.fMaxDcaV0Daught = 1.5; cuts.fMaxDcaCascDaught = 1.0; cuts.fLambdaMassWindow = 0.012; cuts.fXiRejectionWindow = 0;
+    cuts.fMaxCtauXi = 4.91*6; cuts.fMaxCtauOmega = 2.461*6; cuts.fMaxNSigmaTPC = 5;
+    return cuts;
+  }
+};
+
+class AliStrangenessSelection {
+public:
+  //masks of the hypotheses passing the selections
+  enum { kK0sBit = BIT(0), kLambdaBit = BIT(1), kAntiLambdaBit = BIT(2) };
+  enum { kXiPluBit = BIT(0), kXiMinBit = BIT(1), kOmPluBit = BIT(2), kOmMinBit = BIT(3) };
+
+  //_____________________________________________________________________________
+  /// V0, stage 1: kinematics, track quality, topology, proper lifetime
+  static UInt_t SelectV0Topology(const AliV0CandidateBatch &b, Int_t i, const AliV0Cuts &cuts)
+  {
+    UInt_t hypMask = kK0sBit | kLambdaBit | kAntiLambdaBit;
+    // check candidate's rapidity (particle hypothesis' dependent)
+    if( std::fabs(b.fYK0s[i])>cuts.fMaxRapidity ) hypMask &= ~kK0sBit;
+    if( std::fabs(b.fYLam[i])>cuts.fMaxRapidity ) hypMask &= ~(kLambdaBit | kAntiLambdaBit);
+    // check candidate daughters' pseudo-rapidity
+    if( std::fabs(b.fEtaPos[i])>cuts.fMaxDaughterEta || std::fabs(b.fEtaNeg[i])>cuts.fMaxDaughterEta ) return 0;
+    // check candidate daughters' crossed TPC raws (note that the checked value is the lowest between the two daughter)
+    if( b.fLeastCRows[i]<cuts.fMinCrossedRows ) return 0;
+    // check candidate daughters' crossed TPC raws over findable
+    if( b.fLeastCRowsOvF[i]<cuts.fMinCrossedRowsOvF ) return 0;
+    // check candidate daughters' DCA to Primary Vertex (needs to be large because V0 decay is far from the Primary Vertex)
+    if( b.fDcaPosToPV[i]<cuts.fMinDcaDaughToPV || b.fDcaNegToPV[i]<cuts.fMinDcaDaughToPV ) return 0;
+    // check candidate daughters' DCA between them (needs to be small because they have to come from the same secondary vertex)
+    if( b.fDcaV0Daught[i]>cuts.fMaxDcaV0Daught ) return 0;
+    // check candidate's 2D decay distance from PV (if it is too small, then it's not a weak decay)
+    if( b.fV0Rad[i]<cuts.fMinV0Radius ) return 0;
+    // check the cosine of the Pointing Angle (angle between candidate's momentum and vector connecting Primary and secondary vertices)
+    if( b.fV0CosPA[i]<cuts.fMinV0CosPA ) return 0;
+    // check candidate's proper lifetime (particle hypothesis' dependent). Remember: c*tau = L*m/p
+    if( 0.497*b.fDistOverTotP[i] >cuts.fMaxCtauK0s ) hypMask &= ~kK0sBit;
+    if( 1.115683*b.fDistOverTotP[i] >cuts.fMaxCtauLambda ) hypMask &= ~(kLambdaBit | kAntiLambdaBit);
+    //reject Lambda candidates when considering K0s
+    if( std::fabs(b.fInvMassLam[i])<cuts.fK0sLambdaRejection ) hypMask &= ~kK0sBit;
+    return hypMask;
+  }
+
+  /// V0, stage 2: out of bunch pile-up rejection (fIsOOBPileUp filled for the stage-1 survivors)
+  static UInt_t SelectV0PileUp(const AliV0CandidateBatch &b, Int_t i, UInt_t hypMask, Bool_t rejectOOBPileUp)
+  {
+    if (rejectOOBPileUp && b.fIsOOBPileUp[i]) return 0;
+    return hypMask;
+  }
+
+  /// V0, stage 3: PID of the daughters (n-sigma filled for the stage-2 survivors)
+  static UInt_t SelectV0PID(const AliV0CandidateBatch &b, Int_t i, const AliV0Cuts &cuts, UInt_t hypMask)
+  {
+    if( std::fabs(b.fNSigPosPion[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigNegPion[i])>cuts.fMaxNSigmaTPC ) hypMask &= ~kK0sBit;
+    if( std::fabs(b.fNSigPosProton[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigNegPion[i])>cuts.fMaxNSigmaTPC ) hypMask &= ~kLambdaBit;
+    if( std::fabs(b.fNSigNegProton[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigPosPion[i])>cuts.fMaxNSigmaTPC ) hypMask &= ~kAntiLambdaBit;
+    return hypMask;
+  }
+
+  //_____________________________________________________________________________
+  /// record the selection step as passed by all the hypotheses still alive (bit i <-> lastStep[i])
+  static void SetLastStep(UInt_t hypMask, Int_t step, Int_t *lastStep)
+  {
+    for (Int_t iHyp = 0; iHyp < AliCascCandidateBatch::kNHyp; iHyp++) {
+      if (hypMask & BIT(iHyp)) lastStep[iHyp] = step;
+    }
+  }
+
+  /// cascade, stage 1: charge, track quality, kinematics, topology (steps 1, 20, 2-14)
+  static UInt_t SelectCascTopology(const AliCascCandidateBatch &b, Int_t i, const AliCascCuts &cuts, Int_t *lastStep)
+  {
+    //check sign of the Cascade
+    UInt_t hypMask = 0;
+    if (b.fCharge[i]>=0) hypMask |= (kXiPluBit | kOmPluBit);
+    if (b.fCharge[i]<=0) hypMask |= (kXiMinBit | kOmMinBit);
+    SetLastStep(hypMask, 1, lastStep);
+
+    //TPC refit for daughter tracks
+    if (b.fIsNotTPCRefit[i]) return 0;
+    SetLastStep(hypMask, 20, lastStep);
+
+    // check candidate's rapidity (particle hypothesis' dependent)
+    if( std::fabs(b.fYXi[i])>cuts.fMaxRapidity ) hypMask &= ~(kXiPluBit | kXiMinBit);
+    if( std::fabs(b.fYOm[i])>cuts.fMaxRapidity ) hypMask &= ~(kOmPluBit | kOmMinBit);
+    if( !hypMask ) return 0;
+    SetLastStep(hypMask, 2, lastStep);
+
+    // check candidate daughters' pseudo-rapidity
+    if( std::fabs(b.fEtaPos[i])>cuts.fMaxDaughterEta || std::fabs(b.fEtaNeg[i])>cuts.fMaxDaughterEta || std::fabs(b.fEtaBac[i])>cuts.fMaxDaughterEta ) return 0;
+    SetLastStep(hypMask, 3, lastStep);
+
+    // check candidate daughters' crossed TPC raws (note that the checked value is the lowest among the daughters)
+    if( b.fLeastCRows[i]<cuts.fMinCrossedRows ) return 0;
+    SetLastStep(hypMask, 4, lastStep);
+
+    // check candidate daughters' crossed TPC raws over findable
+    if( b.fLeastCRowsOvF[i]<cuts.fMinCrossedRowsOvF ) return 0;
+    SetLastStep(hypMask, 5, lastStep);
+
+    // check candidate's 2D decay distance from PV (if it is too small, then it's not a weak decay)
+    if( b.fCascRad[i]<cuts.fMinCascRadius ) return 0;
+    SetLastStep(hypMask, 6, lastStep);
+
+    // check candidate V0 daughter's 2D decay distance from PV (if it is too small, then it's not a weak decay)
+    if( b.fV0Rad[i]<cuts.fMinV0Radius ) return 0;
+    SetLastStep(hypMask, 7, lastStep);
+
+    // check the cosine of the Pointing Angle for both cascade and V0 (angle between candidate's momentum and vector connecting Primary and secondary vertices)
+    if( b.fCascCosPA[i]<cuts.fMinCascCosPA ) return 0; //same selection for Xi and Omega
+    SetLastStep(hypMask, 8, lastStep);
+
+    if( b.fV0CosPAToXi[i]<cuts.fMinV0CosPAToXi ) return 0;
+    SetLastStep(hypMask, 9, lastStep);
+
+    // check candidate daughters' DCA to Primary Vertex (needs to be large because decay is far from the Primary Vertex)
+    if( b.fDcaBachToPV[i]<cuts.fMinDcaBachToPV ) return 0;
+    SetLastStep(hypMask, 10, lastStep);
+
+    if( b.fDcaV0ToPV[i]<cuts.fMinDcaV0ToPV ) return 0;
+    SetLastStep(hypMask, 11, lastStep);
+
+    // check V0 daughters' DCA to Primary Vertex. Different cut for meson and baryon daughters, so different conditions for + and - candidates
+    if( b.fCharge[i]>0 &&(b.fDcaPosToPV[i] < cuts.fMinDcaMesonToPV || b.fDcaNegToPV[i] < cuts.fMinDcaBaryonToPV)) return 0;
+    if( b.fCharge[i]<0 &&(b.fDcaPosToPV[i] < cuts.fMinDcaBaryonToPV || b.fDcaNegToPV[i] < cuts.fMinDcaMesonToPV)) return 0;
+    SetLastStep(hypMask, 12, lastStep);
+
+    // check V0 daughter's daughters DCA between them (needs to be small because they have to come from the same secondary vertex)
+    if( b.fDcaV0Daught[i]>cuts.fMaxDcaV0Daught ) return 0;
+    SetLastStep(hypMask, 13, lastStep);
+
+    // check candidate daughter's DCA between them (needs to be small because they have to come from the same secondary vertex)
+    if( b.fDcaCascDaught[i]>cuts.fMaxDcaCascDaught ) return 0;
+    SetLastStep(hypMask, 14, lastStep);
+
+    return hypMask;
+  }
+
+  /// cascade, stage 2: out of bunch pile-up, Lambda mass, Xi rejection, proper lifetime (steps 15-18)
+  static UInt_t SelectCascPileUpAndMass(const AliCascCandidateBatch &b, Int_t i, const AliCascCuts &cuts, UInt_t hypMask, Bool_t rejectOOBPileUp, Int_t *lastStep)
+  {
+    if (!hypMask) return 0;
+    if (rejectOOBPileUp && b.fIsOOBPileUp[i]) return 0;
+    SetLastStep(hypMask, 15, lastStep);
+
+    // check candidate V0 daughter's mass difference from nominal Lambda mass
+    if( std::fabs(b.fInvMassLambda[i]-1.115683)>cuts.fLambdaMassWindow) return 0;
+    SetLastStep(hypMask, 16, lastStep);
+
+    //XI rejection (only for Omegas)
+    if( std::fabs(b.fInvMassXi[i]-1.32171)<cuts.fXiRejectionWindow) hypMask &= ~(kOmPluBit | kOmMinBit);
+    SetLastStep(hypMask, 17, lastStep);
+
+    // check candidate's proper lifetime (particle hypothesis' dependent). Remember: c*tau = L*m/p
+    if( 1.32171*b.fDistOverTotP[i] > cuts.fMaxCtauXi ) hypMask &= ~(kXiPluBit | kXiMinBit);
+    if( 1.67245*b.fDistOverTotP[i] > cuts.fMaxCtauOmega ) hypMask &= ~(kOmPluBit | kOmMinBit);
+    SetLastStep(hypMask, 18, lastStep);
+
+    return hypMask;
+  }
+
+  /// cascade, stage 3: PID of the daughters (step 19, n-sigma filled for the stage-2 survivors)
+  static UInt_t SelectCascPID(const AliCascCandidateBatch &b, Int_t i, const AliCascCuts &cuts, UInt_t hypMask, Int_t *lastStep)
+  {
+    if (!hypMask) return 0;
+    if( std::fabs(b.fNSigPosPion[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigNegProton[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigBacPion[i])>cuts.fMaxNSigmaTPC ) hypMask &= ~kXiPluBit;
+    if( std::fabs(b.fNSigNegPion[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigPosProton[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigBacPion[i])>cuts.fMaxNSigmaTPC ) hypMask &= ~kXiMinBit;
+    if( std::fabs(b.fNSigPosPion[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigNegProton[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigBacKaon[i])>cuts.fMaxNSigmaTPC ) hypMask &= ~kOmPluBit;
+    if( std::fabs(b.fNSigNegPion[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigPosProton[i])>cuts.fMaxNSigmaTPC || std::fabs(b.fNSigBacKaon[i])>cuts.fMaxNSigmaTPC ) hypMask &= ~kOmMinBit;
+    SetLastStep(hypMask, 19, lastStep);
+    return hypMask;
+  }
+};
+
+#endif
@@ -0,0 +1,152 @@
+/// \class AliStrangenessCandidateTree
+/// \brief Flat candidate ntuple written from, and read back into, the V0 and cascade candidate batches.
+///
+/// One tree entry per candidate, one float branch per selection variable (same name as the batch
+/// member without the leading f), plus the pile-up flag, the MC truth mask and, for cascades, the
+/// charge and the TPC refit flag. Book() creates the branches for writing, Attach() sets the
+/// addresses of an existing tree for reading and AddEntry() appends the current entry to a batch,
+/// so that the selections of AliStrangenessCandidateBatch.h can be re-run offline unchanged.
+
+#ifndef AliStrangenessCandidateTree_H
+#define AliStrangenessCandidateTree_H
+
+#include <vector>
+#include "TTree.h"
+#include "TString.h"
+#include "AliStrangenessCandidateBatch.h"
+
+template <class Batch>
+class AliStrangenessCandidateTree {
+public:
+  enum { kCompression = 505 }; // ZSTD, level 5
+
+  AliStrangenessCandidateTree() : fTree(0x0), fFloat(), fIsOOBPileUp(0), fMCTrue(0), fCharge(0), fIsNotTPCRefit(0) {}
+
+  /// create the tree in the current directory and its branches
+  TTree* Book(const char *name, const char *title)
+  {
+    fTree = new TTree(name, title);
+    const std::vector<Column> &columns = Columns();
+    fFloat.assign(columns.size(), 0.f);
+    for (size_t k = 0; k < columns.size(); k++) {
+      fTree->Branch(columns[k].fName, &fFloat[k], Form("%s/F", columns[k].fName));
+    }
+    fTree->Branch("IsOOBPileUp", &fIsOOBPileUp, "IsOOBPileUp/b");
+    fTree->Branch("MCTrue", &fMCTrue, "MCTrue/i");
+    BookExtra(static_cast<Batch*>(0x0));
+    fTree->SetAutoFlush(-8000000); // ~8 MB clusters
+    TIter next(fTree->GetListOfBranches());
+    while (TBranch *branch = static_cast<TBranch*>(next())) branch->SetCompressionSettings(kCompression);
+    return fTree;
+  }
+
+  /// read an existing tree: AddEntry() copies the entry last loaded by tree->GetEntry()
+  void Attach(TTree *tree)
+  {
+    fTree = tree;
+    const std::vector<Column> &columns = Columns();
+    fFloat.assign(columns.size(), 0.f);
+    for (size_t k = 0; k < columns.size(); k++) fTree->SetBranchAddress(columns[k].fName, &fFloat[k]);
+    fTree->SetBranchAddress("IsOOBPileUp", &fIsOOBPileUp);
+    fTree->SetBranchAddress("MCTrue", &fMCTrue);
+    AttachExtra(static_cast<Batch*>(0x0));
+  }
+
+  /// write candidate i of the batch
+  void Fill(const Batch &b, Int_t i)
+  {
+    const std::vector<Column> &columns = Columns();
+    for (size_t k = 0; k < columns.size(); k++) fFloat[k] = (b.*(columns[k].fMember))[i];
+    fIsOOBPileUp = b.fIsOOBPileUp[i];
+    fMCTrue = b.fMCTrue[i];
+    FillExtra(b, i);
+    fTree->Fill();
+  }
+
+  /// append the current entry to the batch, returns its index
+  Int_t AddEntry(Batch &b)
+  {
+    Int_t i = b.Add();
+    const std::vector<Column> &columns = Columns();
+    for (size_t k = 0; k < columns.size(); k++) (b.*(columns[k].fMember))[i] = fFloat[k];
+    b.fIsOOBPileUp[i] = fIsOOBPileUp;
+    b.fMCTrue[i] = fMCTrue;
+    AddExtra(b, i);
+    return i;
+  }
+
+  TTree* GetTree() const { return fTree; }
+
+private:
+  struct Column {
+    const char *fName;
+    std::vector<Double_t> Batch::*fMember;
+  };
+  static const std::vector<Column>& Columns();
+
+  //integer columns of the cascades only
+  void BookExtra(AliV0CandidateBatch*) {}
+  void BookExtra(AliCascCandidateBatch*)
+  {
+    fTree->Branch("Charge", &fCharge, "Charge/I");
+    fTree->Branch("IsNotTPCRefit", &fIsNotTPCRefit, "IsNotTPCRefit/b");
+  }
+  void AttachExtra(AliV0CandidateBatch*) {}
+  void AttachExtra(AliCascCandidateBatch*)
+  {
+    fTree->SetBranchAddress("Charge", &fCharge);
+    fTree->SetBranchAddress("IsNotTPCRefit", &fIsNotTPCRefit);
+  }
+  void FillExtra(const AliV0CandidateBatch&, Int_t) {}
+  void FillExtra(const AliCascCandidateBatch &b, Int_t i) { fCharge = b.fCharge[i]; fIsNotTPCRefit = b.fIsNotTPCRefit[i]; }
+  void AddExtra(AliV0CandidateBatch&, Int_t) {}
+  void AddExtra(AliCascCandidateBatch &b, Int_t i) { b.fCharge[i] = fCharge; b.fIsNotTPCRefit[i] = fIsNotTPCRefit; }
+
+  TTree *fTree;                  // not owned
+  std::vector<Float_t> fFloat;   // branch buffers, same order as Columns()
+  UChar_t fIsOOBPileUp;
+  UInt_t  fMCTrue;
+  Int_t   fCharge;
+  UChar_t fIsNotTPCRefit;
+};
+
+template <>
+inline const std::vector<AliStrangenessCandidateTree<AliV0CandidateBatch>::Column>& AliStrangenessCandidateTree<AliV0CandidateBatch>::Columns()
+{
+  typedef AliV0CandidateBatch B;
+  static const Column columns[] = {
+    {"Pt", &B::fPt}, {"YK0s", &B::fYK0s}, {"YLam", &B::fYLam}, {"EtaPos", &B::fEtaPos}, {"EtaNeg", &B::fEtaNeg},
+    {"LeastCRows", &B::fLeastCRows}, {"LeastCRowsOvF", &B::fLeastCRowsOvF},
+    {"DcaPosToPV", &B::fDcaPosToPV}, {"DcaNegToPV", &B::fDcaNegToPV}, {"DcaV0Daught", &B::fDcaV0Daught},
+    {"V0Rad", &B::fV0Rad}, {"V0CosPA", &B::fV0CosPA}, {"DecayLength", &B::fDecayLength}, {"DistOverTotP", &B::fDistOverTotP},
+    {"InvMassK0s", &B::fInvMassK0s}, {"InvMassLam", &B::fInvMassLam}, {"InvMassALam", &B::fInvMassALam},
+    {"NSigPosProton", &B::fNSigPosProton}, {"NSigPosPion", &B::fNSigPosPion},
+    {"NSigNegProton", &B::fNSigNegProton}, {"NSigNegPion", &B::fNSigNegPion}
+  };
+  static const std::vector<Column> list(columns, columns + sizeof(columns) / sizeof(columns[0]));
+  return list;
+}
+
+template <>
+inline const std::vector<AliStrangenessCandidateTree<AliCascCandidateBatch>::Column>& AliStrangenessCandidateTree<AliCascCandidateBatch>::Columns()
+{
+  typedef AliCascCandidateBatch B;
+  static const Column columns[] = {
+    {"Pt", &B::fPt}, {"YXi", &B::fYXi}, {"YOm", &B::fYOm}, {"EtaPos", &B::fEtaPos}, {"EtaNeg", &B::fEtaNeg}, {"EtaBac", &B::fEtaBac},
+    {"LeastCRows", &B::fLeastCRows}, {"LeastCRowsOvF", &B::fLeastCRowsOvF},
+    {"CascRad", &B::fCascRad}, {"V0Rad", &B::fV0Rad}, {"CascCosPA", &B::fCascCosPA}, {"V0CosPA", &B::fV0CosPA}, {"V0CosPAToXi", &B::fV0CosPAToXi},
+    {"DcaBachToPV", &B::fDcaBachToPV}, {"DcaV0ToPV", &B::fDcaV0ToPV}, {"DcaPosToPV", &B::fDcaPosToPV}, {"DcaNegToPV", &B::fDcaNegToPV},
+    {"DcaV0Daught", &B::fDcaV0Daught}, {"DcaCascDaught", &B::fDcaCascDaught},
+    {"DecayLength", &B::fDecayLength}, {"DistOverTotP", &B::fDistOverTotP}, {"V0DistOverTotP", &B::fV0DistOverTotP},
+    {"InvMassLambda", &B::fInvMassLambda}, {"InvMassXi", &B::fInvMassXi}, {"InvMassOm", &B::fInvMassOm},
+    {"NSigPosProton", &B::fNSigPosProton}, {"NSigPosPion", &B::fNSigPosPion}, {"NSigNegProton", &B::fNSigNegProton},
+    {"NSigNegPion", &B::fNSigNegPion}, {"NSigBacPion", &B::fNSigBacPion}, {"NSigBacKaon", &B::fNSigBacKaon}
+  };
+  static const std::vector<Column> list(columns, columns + sizeof(columns) / sizeof(columns[0]));
+  return list;
+}
+
+typedef AliStrangenessCandidateTree<AliV0CandidateBatch>   AliV0CandidateTree;
+typedef AliStrangenessCandidateTree<AliCascCandidateBatch> AliCascCandidateTree;
+
+#endif
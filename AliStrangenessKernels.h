@@ -0,0 +1,186 @@
+/// \file AliStrangenessKernels.h
+/// \brief Stateless kinematics and topology kernels for the V0 and cascade candidates.
+///
+/// Plain functions of the daughter momenta with the daughter masses fixed at compile time.
+/// They do not touch the event: the cascade masses are computed here instead of switching the
+/// mass hypothesis of the AliESDcascade, and the same code serves the ESD and AOD inputs.
+/// The topology kernels (decay length, proper lifetime, cosPA, DCA) take the points and the
+/// momenta as 3-arrays of float or double and contain no branches; the batch versions run
+/// them over struct-of-arrays candidates in loops that the compiler can vectorise. They carry
+/// no AliRoot dependency and are shared with the O2 strangeness filters.
+
+#ifndef AliStrangenessKernels_H
+#define AliStrangenessKernels_H
+
+#include <cmath>
+
+namespace AliStrangenessKernels
+{
+
+// PDG masses (GeV/c^2)
+constexpr double kMassPion   = 0.13957039;
+constexpr double kMassKaon   = 0.493677;
+constexpr double kMassProton = 0.93827208;
+constexpr double kMassK0Short = 0.497611;
+constexpr double kMassLambda = 1.115683;
+constexpr double kMassXi     = 1.32171;
+constexpr double kMassOmega  = 1.67245;
+
+template <typename T>
+inline T Mom2(const T *p) { return p[0] * p[0] + p[1] * p[1] + p[2] * p[2]; }
+
+/// invariant mass of two daughters with momenta p1, p2 and masses m1, m2
+inline double InvariantMass(const double *p1, double m1, const double *p2, double m2)
+{
+  const double e = std::sqrt(m1 * m1 + Mom2(p1)) + std::sqrt(m2 * m2 + Mom2(p2));
+  const double p[3] = {p1[0] + p2[0], p1[1] + p2[1], p1[2] + p2[2]};
+  const double m2tot = e * e - Mom2(p);
+  return m2tot > 0. ? std::sqrt(m2tot) : 0.;
+}
+
+/// rapidity of a particle of momentum p and mass m, with the 1e-13 guard of AliESDcascade::RapXi
+inline double Rapidity(const double *p, double m)
+{
+  const double e = std::sqrt(m * m + Mom2(p));
+  return 0.5 * std::log((e + p[2]) / (e - p[2] + 1e-13));
+}
+
+struct CascadeMasses {
+  double fMassLambda; // V0 daughters as Lambda (charge < 0) or anti-Lambda (charge > 0)
+  double fMassXi;     // V0 at the Lambda mass + bachelor pion
+  double fMassOmega;  // V0 at the Lambda mass + bachelor kaon
+  double fRapXi;      // cascade rapidity, Xi mass
+  double fRapOmega;   // cascade rapidity, Omega mass
+};
+
+/// all the mass hypotheses of a cascade in one go, from the daughter momenta at the decay vertices
+inline CascadeMasses CascadeMassesAndRapidities(const double *posMom, const double *negMom, const double *bachMom, int charge)
+{
+  CascadeMasses result;
+  const bool isAnti = charge > 0;
+  result.fMassLambda = InvariantMass(posMom, isAnti ? kMassPion : kMassProton, negMom, isAnti ? kMassProton : kMassPion);
+  const double v0Mom[3] = {posMom[0] + negMom[0], posMom[1] + negMom[1], posMom[2] + negMom[2]};
+  result.fMassXi = InvariantMass(v0Mom, kMassLambda, bachMom, kMassPion);
+  result.fMassOmega = InvariantMass(v0Mom, kMassLambda, bachMom, kMassKaon);
+  const double cascMom[3] = {v0Mom[0] + bachMom[0], v0Mom[1] + bachMom[1], v0Mom[2] + bachMom[2]};
+  result.fRapXi = Rapidity(cascMom, kMassXi);
+  result.fRapOmega = Rapidity(cascMom, kMassOmega);
+  return result;
+}
+
+// ---------------------------------------------------------------------------------------------
+// topology
+
+/// squared distance between the points a and b
+template <typename T>
+inline T Distance2(const T *a, const T *b)
+{
+  const T d[3] = {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+  return Mom2(d);
+}
+
+/// decay length: distance between the decay vertex and the primary (or mother) vertex
+template <typename T>
+inline T DecayLength(const T *decayVtx, const T *primVtx) { return std::sqrt(Distance2(decayVtx, primVtx)); }
+
+/// transverse radius of a point
+template <typename T>
+inline T TransverseRadius(const T *pos) { return std::sqrt(pos[0] * pos[0] + pos[1] * pos[1]); }
+
+/// decay length over total momentum (times the mass gives c*tau), 1e-10 avoids the division by zero
+template <typename T>
+inline T DistOverTotMom(const T *decayVtx, const T *primVtx, const T *p)
+{
+  return DecayLength(decayVtx, primVtx) / (std::sqrt(Mom2(p)) + T(1e-10));
+}
+
+/// proper lifetime cut without square roots: m * L / p < cut  <=>  m^2 * L^2 < cut^2 * p^2, for
+/// a non-negative cut; takes the squared decay length (Distance2) and the squared momentum (Mom2)
+inline bool ProperLifetimeBelow(double mass, double decayLength2, double mom2, double cut)
+{
+  return mass * mass * decayLength2 < cut * cut * mom2;
+}
+
+/// cosine of the angle between the momentum p and the flight line primVtx -> decayVtx, 1 if either vanishes
+template <typename T>
+inline T CosPA(const T *decayVtx, const T *primVtx, const T *p)
+{
+  const T d[3] = {decayVtx[0] - primVtx[0], decayVtx[1] - primVtx[1], decayVtx[2] - primVtx[2]};
+  const T norm2 = Mom2(d) * Mom2(p);
+  const T dot = d[0] * p[0] + d[1] * p[1] + d[2] * p[2];
+  return norm2 > T(0) ? dot / std::sqrt(norm2) : T(1);
+}
+
+/// distance of closest approach of the straight line through pos along p to the point vtx
+template <typename T>
+inline T DCAToPoint(const T *pos, const T *p, const T *vtx)
+{
+  const T d[3] = {pos[0] - vtx[0], pos[1] - vtx[1], pos[2] - vtx[2]};
+  const T c[3] = {d[1] * p[2] - d[2] * p[1], d[2] * p[0] - d[0] * p[2], d[0] * p[1] - d[1] * p[0]};
+  const T p2 = Mom2(p);
+  return p2 > T(0) ? std::sqrt(Mom2(c) / p2) : std::sqrt(Mom2(d));
+}
+
+// ---------------------------------------------------------------------------------------------
+// batch versions: n candidates in struct-of-arrays layout (decay vertex x, y, z and momentum
+// px, py, pz), one primary vertex for all of them. ProperLifetimesBelow has no square root and
+// is always vectorised; the loops with std::sqrt only with -fno-math-errno (errno path of sqrt)
+
+template <typename T>
+inline void DecayLengths(int n, const T *__restrict x, const T *__restrict y, const T *__restrict z, const T *primVtx, T *__restrict out)
+{
+  const T vx = primVtx[0], vy = primVtx[1], vz = primVtx[2];
+  for (int i = 0; i < n; i++) {
+    out[i] = std::sqrt((x[i] - vx) * (x[i] - vx) + (y[i] - vy) * (y[i] - vy) + (z[i] - vz) * (z[i] - vz));
+  }
+}
+
+template <typename T>
+inline void DistOverTotMoms(int n, const T *__restrict x, const T *__restrict y, const T *__restrict z,
+                            const T *__restrict px, const T *__restrict py, const T *__restrict pz, const T *primVtx, T *__restrict out)
+{
+  const T vx = primVtx[0], vy = primVtx[1], vz = primVtx[2];
+  for (int i = 0; i < n; i++) {
+    const T l2 = (x[i] - vx) * (x[i] - vx) + (y[i] - vy) * (y[i] - vy) + (z[i] - vz) * (z[i] - vz);
+    out[i] = std::sqrt(l2) / (std::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]) + T(1e-10));
+  }
+}
+
+/// out[i] = 1 if the proper lifetime of candidate i for the given mass is below cut, 0 otherwise
+template <typename T>
+inline void ProperLifetimesBelow(int n, T mass, T cut, const T *__restrict x, const T *__restrict y, const T *__restrict z,
+                                 const T *__restrict px, const T *__restrict py, const T *__restrict pz, const T *primVtx, unsigned char *__restrict out)
+{
+  const T vx = primVtx[0], vy = primVtx[1], vz = primVtx[2];
+  const T m2 = mass * mass, cut2 = cut * cut;
+  for (int i = 0; i < n; i++) {
+    const T l2 = (x[i] - vx) * (x[i] - vx) + (y[i] - vy) * (y[i] - vy) + (z[i] - vz) * (z[i] - vz);
+    out[i] = m2 * l2 < cut2 * (px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+  }
+}
+
+template <typename T>
+inline void CosPAs(int n, const T *__restrict x, const T *__restrict y, const T *__restrict z,
+                   const T *__restrict px, const T *__restrict py, const T *__restrict pz, const T *primVtx, T *__restrict out)
+{
+  const T vx = primVtx[0], vy = primVtx[1], vz = primVtx[2];
+  for (int i = 0; i < n; i++) {
+    const T dx = x[i] - vx, dy = y[i] - vy, dz = z[i] - vz;
+    const T norm2 = (dx * dx + dy * dy + dz * dz) * (px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+    const T dot = dx * px[i] + dy * py[i] + dz * pz[i];
+    out[i] = norm2 > T(0) ? dot / std::sqrt(norm2) : T(1);
+  }
+}
+
+template <typename T>
+inline void Rapidities(int n, T mass, const T *__restrict px, const T *__restrict py, const T *__restrict pz, T *__restrict out)
+{
+  for (int i = 0; i < n; i++) {
+    const T e = std::sqrt(mass * mass + px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+    out[i] = T(0.5) * std::log((e + pz[i]) / (e - pz[i]));
+  }
+}
+
+} // namespace AliStrangenessKernels
+
+#endif
@@ -0,0 +1,101 @@
+/// \class AliStrangenessMCIndex
+/// \brief Flat per-event index of the MC truth used for the V0 and cascade truth matching.
+///
+/// Built once per event from the AOD MC particle array or from the ESD MC event, it holds for
+/// every MC label the PDG code, the mother and grandmother labels and the physical-primary
+/// flag in contiguous memory, so that the association of a candidate costs a few integer
+/// comparisons instead of repeated TClonesArray::At and virtual getter calls.
+/// Labels outside the index (e.g. negative mother labels) return an entry with PDG code 0.
+/// Each entry also carries the slot of the strange species (K0s ... Omega+, see SpeciesSlot()),
+/// -1 for every other particle, so that the generated-particle loops reject the non-strange
+/// particles with a single comparison.
+
+#ifndef AliStrangenessMCIndex_H
+#define AliStrangenessMCIndex_H
+
+#include <vector>
+#include "TClonesArray.h"
+#include "TParticle.h"
+#include "AliAODMCParticle.h"
+#include "AliMCEvent.h"
+
+struct AliStrangenessMCEntry {
+  Int_t  fPdg;          // PDG code
+  Int_t  fMother;       // label of the mother (-1 if none)
+  Int_t  fGrandMother;  // label of the grandmother (-1 if none)
+  Bool_t fIsPhysPrim;   // physical primary
+  Int_t  fSlot;         // strange species slot, -1 if none
+};
+
+class AliStrangenessMCIndex {
+public:
+  enum ESpeciesSlot { kK0s, kLambda, kAntiLambda, kXiMinus, kXiPlus, kOmegaMinus, kOmegaPlus, kNSpeciesSlots };
+
+  AliStrangenessMCIndex() : fEntries(), fInvalid() { fInvalid.fPdg = 0; fInvalid.fMother = -1; fInvalid.fGrandMother = -1; fInvalid.fIsPhysPrim = kFALSE; fInvalid.fSlot = -1; }
+
+  /// species slot of a PDG code, -1 for the non-strange particles: perfect hash of |pdg| modulo 13
+  static Int_t SpeciesSlot(Int_t pdg)
+  {
+    static const Int_t kKeys[13]      = { 0, 0, 3122, 0, 0, 0, 3334, 0, 0, 0, 3312, 310, 0 };
+    static const Int_t kParticle[13]  = { -1, -1, kLambda, -1, -1, -1, kOmegaMinus, -1, -1, -1, kXiMinus, kK0s, -1 };
+    static const Int_t kAntiPart[13]  = { -1, -1, kAntiLambda, -1, -1, -1, kOmegaPlus, -1, -1, -1, kXiPlus, -1, -1 };
+    Int_t absPdg = pdg < 0 ? -pdg : pdg;
+    Int_t h = absPdg % 13;
+    if (kKeys[h] != absPdg) return -1;
+    return pdg > 0 ? kParticle[h] : kAntiPart[h];
+  }
+
+  /// AOD: MC particles from the AliAODMCParticle::StdBranchName() array
+  void Build(TClonesArray *mcArray)
+  {
+    fEntries.clear();
+    if (!mcArray) return;
+    Int_t nParticles = mcArray->GetEntriesFast();
+    fEntries.resize(nParticles, fInvalid);
+    for (Int_t i = 0; i < nParticles; i++) {
+      AliAODMCParticle *particle = static_cast<AliAODMCParticle*>(mcArray->At(i));
+      if (!particle) continue;
+      fEntries[i].fPdg = particle->GetPdgCode();
+      fEntries[i].fMother = particle->GetMother();
+      fEntries[i].fIsPhysPrim = particle->IsPhysicalPrimary();
+      fEntries[i].fSlot = SpeciesSlot(fEntries[i].fPdg);
+    }
+    FillGrandMothers();
+  }
+
+  /// ESD: MC particles from the stack of the MC event
+  void Build(AliMCEvent *mcEvent)
+  {
+    fEntries.clear();
+    if (!mcEvent) return;
+    Int_t nParticles = mcEvent->GetNumberOfTracks();
+    fEntries.resize(nParticles, fInvalid);
+    for (Int_t i = 0; i < nParticles; i++) {
+      TParticle *particle = mcEvent->Particle(i);
+      if (!particle) continue;
+      fEntries[i].fPdg = particle->GetPdgCode();
+      fEntries[i].fMother = particle->GetFirstMother();
+      fEntries[i].fIsPhysPrim = mcEvent->IsPhysicalPrimary(i);
+      fEntries[i].fSlot = SpeciesSlot(fEntries[i].fPdg);
+    }
+    FillGrandMothers();
+  }
+
+  void   Clear() { fEntries.clear(); }
+  Int_t  GetEntries() const { return fEntries.size(); }
+  Bool_t IsValid(Int_t label) const { return label >= 0 && label < (Int_t)fEntries.size(); }
+  const AliStrangenessMCEntry& At(Int_t label) const { return IsValid(label) ? fEntries[label] : fInvalid; }
+
+private:
+  void FillGrandMothers()
+  {
+    for (size_t i = 0; i < fEntries.size(); i++) {
+      fEntries[i].fGrandMother = At(fEntries[i].fMother).fMother;
+    }
+  }
+
+  std::vector<AliStrangenessMCEntry> fEntries; // one entry per MC label
+  AliStrangenessMCEntry fInvalid;              // returned for labels outside the index
+};
+
+#endif
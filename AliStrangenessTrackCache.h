@@ -0,0 +1,91 @@
+/// \class AliStrangenessTrackCache
+/// \brief Per-event cache of the daughter-track quantities used in the V0 and cascade selections.
+///
+/// The same track enters as daughter many V0 and cascade candidates of an event. The TPC
+/// n-sigma (pion, kaon, proton), the TPC crossed rows and the TOF bunch crossing are computed
+/// the first time they are asked for a given track and then reused for all the other candidates.
+/// Reset() must be called at the beginning of every event: the tracks are identified by their
+/// address, which is only unique within one event.
+
+#ifndef AliStrangenessTrackCache_H
+#define AliStrangenessTrackCache_H
+
+#include <unordered_map>
+#include "AliPID.h"
+#include "AliPIDResponse.h"
+#include "AliVTrack.h"
+
+class AliStrangenessTrackCache {
+public:
+  AliStrangenessTrackCache() : fPIDResponse(0x0), fMagneticField(0.), fEntries() {}
+
+  /// new event: forget all the tracks of the previous one
+  void Reset(AliPIDResponse *pidResponse, Double_t magneticField)
+  {
+    fPIDResponse = pidResponse;
+    fMagneticField = magneticField;
+    fEntries.clear();
+  }
+
+  /// TPC n-sigma, memoised for pions, kaons and protons
+  Float_t NSigmaTPC(const AliVTrack *track, AliPID::EParticleType type)
+  {
+    Int_t slot = Slot(type);
+    if (slot < 0) return fPIDResponse->NumberOfSigmasTPC(track, type);
+    Entry &entry = fEntries[track];
+    if (!(entry.fDone & BIT(slot))) {
+      entry.fNSigmaTPC[slot] = fPIDResponse->NumberOfSigmasTPC(track, type);
+      entry.fDone |= BIT(slot);
+    }
+    return entry.fNSigmaTPC[slot];
+  }
+
+  /// TPC crossed rows, as given by GetTPCClusterInfo(2,1)
+  Float_t CrossedRows(const AliVTrack *track)
+  {
+    Entry &entry = fEntries[track];
+    if (!(entry.fDone & kCrossedRowsBit)) {
+      entry.fCrossedRows = track->GetTPCClusterInfo(2, 1);
+      entry.fDone |= kCrossedRowsBit;
+    }
+    return entry.fCrossedRows;
+  }
+
+  /// TOF bunch crossing, evaluated with the magnetic field given in Reset()
+  Int_t TOFBunchCrossing(const AliVTrack *track)
+  {
+    Entry &entry = fEntries[track];
+    if (!(entry.fDone & kTOFBunchCrossingBit)) {
+      entry.fTOFBunchCrossing = track->GetTOFBunchCrossing(fMagneticField);
+      entry.fDone |= kTOFBunchCrossingBit;
+    }
+    return entry.fTOFBunchCrossing;
+  }
+
+private:
+  enum { kPionSlot = 0, kKaonSlot, kProtonSlot, kNSlots };
+  enum { kCrossedRowsBit = BIT(kNSlots), kTOFBunchCrossingBit = BIT(kNSlots + 1) };
+
+  struct Entry {
+    Float_t fNSigmaTPC[kNSlots]; // TPC n-sigma for pion, kaon and proton
+    Float_t fCrossedRows;        // TPC crossed rows
+    Int_t   fTOFBunchCrossing;   // TOF bunch crossing
+    UInt_t  fDone;               // bits of the quantities already computed
+  };
+
+  static Int_t Slot(AliPID::EParticleType type)
+  {
+    switch (type) {
+      case AliPID::kPion:   return kPionSlot;
+      case AliPID::kKaon:   return kKaonSlot;
+      case AliPID::kProton: return kProtonSlot;
+      default:              return -1;
+    }
+  }
+
+  AliPIDResponse *fPIDResponse;                           // PID response of the current event
+  Double_t fMagneticField;                                // magnetic field of the current event
+  std::unordered_map<const AliVTrack*, Entry> fEntries;   // value-initialised on first access (fDone = 0)
+};
+
+#endif
@@ -0,0 +1,58 @@
+/// \class AliStrangenessWarningCounter
+/// \brief Rate-limited, aggregated warnings for the event and candidate loops.
+///
+/// Each warning site of a task is one bin of a labelled counter histogram that goes to the
+/// task output and is merged with it. Count() only increments the counter and prints the
+/// message of the site, unformatted, for its first fMaxPrinted occurrences; PrintSummary()
+/// prints the totals from the (merged) histogram, typically in Terminate().
+
+#ifndef AliStrangenessWarningCounter_H
+#define AliStrangenessWarningCounter_H
+
+#include <vector>
+#include "TH1F.h"
+#include "TError.h"
+
+class AliStrangenessWarningCounter {
+public:
+  AliStrangenessWarningCounter() : fHist(0x0), fLocation(""), fMessages(0x0), fCounts(), fMaxPrinted(10) {}
+
+  /// counter histogram with one bin per site; messages must have static storage, location is usually the task name
+  TH1F* Book(const char *name, const char *location, Int_t nSites, const char *const *messages)
+  {
+    fLocation = location;
+    fMessages = messages;
+    fCounts.assign(nSites, 0);
+    fHist = new TH1F(name, "Warnings;;Occurrences", nSites, 0, nSites);
+    for (Int_t i = 0; i < nSites; i++) fHist->GetXaxis()->SetBinLabel(i + 1, messages[i]);
+    return fHist;
+  }
+  void SetMaxPrinted(Long64_t maxPrinted) { fMaxPrinted = maxPrinted; }
+
+  /// hot path: no string formatting past the first fMaxPrinted occurrences of a site
+  void Count(Int_t site)
+  {
+    Long64_t count = ++fCounts[site];
+    if (fHist) fHist->Fill(site);
+    if (count < fMaxPrinted) ::Warning(fLocation, "%s", fMessages[site]);
+    else if (count == fMaxPrinted) ::Warning(fLocation, "%s (further occurrences are only counted)", fMessages[site]);
+  }
+
+  /// totals per site from a counter histogram, e.g. retrieved from the merged output
+  static void PrintSummary(const char *location, const TH1 *hist)
+  {
+    if (!hist) return;
+    for (Int_t i = 1; i <= hist->GetNbinsX(); i++) {
+      if (hist->GetBinContent(i) > 0) ::Info(location, "%12.0f x %s", hist->GetBinContent(i), hist->GetXaxis()->GetBinLabel(i));
+    }
+  }
+
+private:
+  TH1F *fHist;                    // counter histogram, owned by the output list
+  const char *fLocation;          // location printed with the messages
+  const char *const *fMessages;   // one message per site
+  std::vector<Long64_t> fCounts;  // occurrences per site in this job
+  Long64_t fMaxPrinted;           // occurrences printed per site
+};
+
+#endif
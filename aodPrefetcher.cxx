@@ -0,0 +1,412 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+/// \brief Read-ahead of the AO2D files of an input list for the DPL AOD reader
+//  usage:
+/*
+  o2-analysis-aod-prefetcher -n 4 -m 8000 inputList.txt &
+  o2-analysis-timestamp -b --aod-file @inputList.txt | ... | o2-analysis-strangeness-filter -b
+  reference on the same list, reader alone from a cold cache:
+  o2-analysis-aod-prefetcher -o -c inputList.txt &
+  o2-analysis-timestamp -b --aod-file @inputList.txt | ... | o2-analysis-strangeness-filter -b
+*/
+///  The reader device opens the files of the list one after the other, so at every file
+///  boundary the whole chain waits for the next file to come from disk. The prefetcher runs
+///  next to the pipeline: it follows the reader through /proc/<pid>/fd and keeps the next
+///  files of the list in the page cache, read by a pool of threads, within a memory cap.
+///  The memory cap counts the files read ahead and not yet consumed; consumed files stay in
+///  the cache (other jobs may read them) unless -e is given.
+///  At the end it reports the reader wait on the input: the time the reader spent in disk
+///  wait (state D of its threads, sampled every 5 ms) while each file of the list was the
+///  one it had last opened. With -o the files are not read ahead and the same measurement
+///  gives the reference of the reader alone; compare the two runs on the same list, both
+///  with -c. The decompression stays in the reader.
+///  Options:
+///   -n <threads>   files read ahead in parallel (default 4)
+///   -m <MB>        cap on the bytes read ahead and not yet consumed (default 4000)
+///   -p <pid>       reader process (default: the first process with "internal-dpl-aod-reader" in its command line)
+///   -c             cold start: drop the listed files from the page cache first
+///   -e             evict the files consumed by the reader from the page cache; only when no
+///                  other job reads the same files
+///   -o             observe only: no read-ahead, reference measurement of the reader wait
+///  Only local (or mounted) paths are prefetched; remote URLs are left to the reader.
+///
+/// \author Francesca Ercolessi (francesca.ercolessi@cern.ch)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+enum class FileState { Pending,
+                       Loading,
+                       Resident,
+                       Consumed,
+                       Skipped };
+
+struct ListedFile {
+  std::string path;
+  std::string realPath; // as seen in /proc/<pid>/fd
+  long long size = 0;
+  FileState state = FileState::Pending;
+  double loadSeconds = 0.;  // read-ahead time
+  bool opened = false;      // seen open by the reader
+  double waitSeconds = 0.;  // reader in disk wait while this was its last opened file
+};
+
+void dropFromCache(const ListedFile& file)
+{
+  int fd = open(file.path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+}
+
+/// running and not a zombie waiting for its parent
+bool isAlive(int pid)
+{
+  std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+  std::string line;
+  if (!std::getline(stat, line)) {
+    return false;
+  }
+  size_t end = line.rfind(')'); // the command name may contain spaces
+  return end != std::string::npos && end + 2 < line.size() && line[end + 2] != 'Z';
+}
+
+/// one of the threads of the process in uninterruptible (disk) wait
+bool isWaitingOnDisk(int pid)
+{
+  std::string taskDir = "/proc/" + std::to_string(pid) + "/task";
+  DIR* dir = opendir(taskDir.c_str());
+  if (!dir) {
+    return false;
+  }
+  bool waiting = false;
+  while (dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    std::ifstream stat(taskDir + "/" + entry->d_name + "/stat");
+    std::string line;
+    if (std::getline(stat, line)) {
+      size_t end = line.rfind(')');
+      if (end != std::string::npos && end + 2 < line.size() && line[end + 2] == 'D') {
+        waiting = true;
+        break;
+      }
+    }
+  }
+  closedir(dir);
+  return waiting;
+}
+
+class Prefetcher
+{
+ public:
+  Prefetcher(std::vector<ListedFile> files, int nThreads, long long memoryCap, bool evict) : mFiles(std::move(files)), mThreads(nThreads), mMemoryCap(memoryCap), mEvict(evict) {}
+
+  /// reads the file through once, leaving its pages in the cache
+  double load(const ListedFile& file)
+  {
+    auto start = Clock::now();
+    int fd = open(file.path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return 0.;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    std::vector<char> buffer(4 << 20);
+    while (read(fd, buffer.data(), buffer.size()) > 0) {
+    }
+    close(fd);
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  /// next file to read ahead within the memory cap; the first one in flight is always allowed
+  int next()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+      int candidate = -1;
+      for (size_t i = mReaderAt < 0 ? 0 : mReaderAt; i < mFiles.size(); i++) {
+        if (mFiles[i].state == FileState::Pending) {
+          candidate = i;
+          break;
+        }
+      }
+      if (candidate < 0 || mDone) {
+        return -1;
+      }
+      if (mInFlight == 0 || mInFlight + mFiles[candidate].size <= mMemoryCap) {
+        mFiles[candidate].state = FileState::Loading;
+        mInFlight += mFiles[candidate].size;
+        return candidate;
+      }
+      mCondition.wait(lock);
+    }
+  }
+
+  void worker()
+  {
+    int i;
+    while ((i = next()) >= 0) {
+      double seconds = load(mFiles[i]);
+      std::lock_guard<std::mutex> lock(mMutex);
+      ListedFile& file = mFiles[i];
+      file.loadSeconds = seconds;
+      file.state = file.state == FileState::Consumed ? FileState::Consumed : FileState::Resident;
+      mCondition.notify_all();
+    }
+  }
+
+  /// files of the list currently open in the reader
+  std::vector<int> openInReader(int pid)
+  {
+    std::vector<int> open;
+    std::string fdDir = "/proc/" + std::to_string(pid) + "/fd";
+    DIR* dir = opendir(fdDir.c_str());
+    if (!dir) {
+      return open;
+    }
+    char target[4096];
+    while (dirent* entry = readdir(dir)) {
+      std::string link = fdDir + "/" + entry->d_name;
+      ssize_t n = readlink(link.c_str(), target, sizeof(target) - 1);
+      if (n <= 0) {
+        continue;
+      }
+      target[n] = '\0';
+      for (size_t i = 0; i < mFiles.size(); i++) {
+        if (mFiles[i].realPath == target) {
+          open.push_back(i);
+        }
+      }
+    }
+    closedir(dir);
+    return open;
+  }
+
+  /// follows the reader until it exits, the files before the one it reads are consumed;
+  /// the disk wait of the reader goes to its last opened file
+  void monitor(int pid)
+  {
+    auto last = Clock::now();
+    while (isAlive(pid)) {
+      std::vector<int> open = openInReader(pid);
+      bool waiting = isWaitingOnDisk(pid);
+      auto now = Clock::now();
+      double elapsed = std::chrono::duration<double>(now - last).count();
+      last = now;
+      std::unique_lock<std::mutex> lock(mMutex);
+      for (int i : open) {
+        mFiles[i].opened = true;
+        mReaderAt = std::max(mReaderAt, i);
+      }
+      if (waiting && mReaderAt >= 0) {
+        mFiles[mReaderAt].waitSeconds += elapsed;
+      }
+      for (int i = 0; i < mReaderAt; i++) {
+        ListedFile& file = mFiles[i];
+        if (file.state == FileState::Resident || file.state == FileState::Pending) {
+          if (file.state == FileState::Resident) {
+            mInFlight -= file.size;
+            if (mEvict) {
+              dropFromCache(file);
+            }
+          }
+          file.state = FileState::Consumed;
+          mCondition.notify_all();
+        }
+      }
+      lock.unlock();
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+
+  void run(int pid)
+  {
+    std::vector<std::thread> pool;
+    for (int t = 0; t < mThreads; t++) {
+      pool.emplace_back(&Prefetcher::worker, this);
+    }
+    if (pid > 0) {
+      monitor(pid);
+      std::lock_guard<std::mutex> lock(mMutex);
+      mDone = true;
+      mCondition.notify_all();
+    }
+    for (auto& thread : pool) {
+      thread.join();
+    }
+  }
+
+  void report() const
+  {
+    double wait = 0., maxWait = 0.;
+    int nLoaded = 0, nOpened = 0;
+    for (const auto& file : mFiles) {
+      nLoaded += file.loadSeconds > 0.;
+      if (file.opened) {
+        wait += file.waitSeconds;
+        maxWait = std::max(maxWait, file.waitSeconds);
+        nOpened++;
+      }
+    }
+    printf("aod-prefetcher: %d / %zu files read ahead, %d opened by the reader\n", nLoaded, mFiles.size(), nOpened);
+    printf("aod-prefetcher: reader disk wait %s read-ahead: %.2f s, %.3f s per file (max %.3f s)\n",
+           mThreads > 0 ? "with" : "without", wait, nOpened ? wait / nOpened : 0., maxWait);
+  }
+
+ private:
+  std::vector<ListedFile> mFiles;
+  int mThreads;
+  long long mMemoryCap;
+  bool mEvict;             // consumed files dropped from the page cache
+  long long mInFlight = 0; // bytes read ahead and not consumed
+  int mReaderAt = -1;      // last file of the list opened by the reader
+  bool mDone = false;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+};
+
+/// first process with "internal-dpl-aod-reader" in its command line, waiting for it to start
+int findReader()
+{
+  const std::string readerId("--id\0internal-dpl-aod-reader", 28); // /proc/<pid>/cmdline is NUL-separated
+  for (int attempt = 0; attempt < 6000; attempt++) {
+    DIR* proc = opendir("/proc");
+    while (dirent* entry = readdir(proc)) {
+      int pid = atoi(entry->d_name);
+      if (pid <= 0 || pid == getpid()) {
+        continue;
+      }
+      std::ifstream cmdline("/proc/" + std::string(entry->d_name) + "/cmdline");
+      std::string content((std::istreambuf_iterator<char>(cmdline)), std::istreambuf_iterator<char>());
+      if (content.find(readerId) != std::string::npos) {
+        closedir(proc);
+        return pid;
+      }
+    }
+    closedir(proc);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return -1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  int nThreads = 4;
+  long long memoryCapMB = 4000;
+  int pid = -1;
+  bool coldStart = false;
+  bool evict = false;
+  bool observeOnly = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "n:m:p:ceo")) != -1) {
+    switch (opt) {
+      case 'n':
+        nThreads = std::max(1, atoi(optarg));
+        break;
+      case 'm':
+        memoryCapMB = atoll(optarg);
+        break;
+      case 'p':
+        pid = atoi(optarg);
+        break;
+      case 'c':
+        coldStart = true;
+        break;
+      case 'e':
+        evict = true;
+        break;
+      case 'o':
+        observeOnly = true;
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-n threads] [-m memory cap MB] [-p reader pid] [-c] [-e] [-o] inputList.txt\n", argv[0]);
+        return 1;
+    }
+  }
+  if (optind >= argc) {
+    fprintf(stderr, "usage: %s [-n threads] [-m memory cap MB] [-p reader pid] [-c] [-e] [-o] inputList.txt\n", argv[0]);
+    return 1;
+  }
+
+  // same list format as aod-file: one file per line, '@' prefix of the list optional
+  std::string listName = argv[optind];
+  if (!listName.empty() && listName[0] == '@') {
+    listName.erase(0, 1);
+  }
+  std::ifstream list(listName);
+  if (!list) {
+    fprintf(stderr, "aod-prefetcher: cannot open %s\n", listName.c_str());
+    return 1;
+  }
+  std::vector<ListedFile> files;
+  std::string line;
+  while (std::getline(list, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    ListedFile file;
+    file.path = line.compare(0, 7, "file://") == 0 ? line.substr(7) : line;
+    struct stat info;
+    char* real = realpath(file.path.c_str(), nullptr);
+    if (line.find("://") != std::string::npos && line.compare(0, 7, "file://") != 0) {
+      file.state = FileState::Skipped; // remote, left to the reader
+    } else if (!real || stat(real, &info) != 0) {
+      fprintf(stderr, "aod-prefetcher: %s not found, skipped\n", file.path.c_str());
+      file.state = FileState::Skipped;
+    } else {
+      file.realPath = real;
+      file.size = info.st_size;
+    }
+    free(real);
+    files.push_back(file);
+  }
+
+  if (coldStart) {
+    for (const auto& file : files) {
+      if (file.state != FileState::Skipped) {
+        dropFromCache(file);
+      }
+    }
+  }
+  Prefetcher prefetcher(std::move(files), observeOnly ? 0 : nThreads, memoryCapMB << 20, evict);
+  if (pid < 0) {
+    pid = findReader();
+    if (pid < 0) {
+      fprintf(stderr, "aod-prefetcher: no internal-dpl-aod-reader process found\n");
+      return 1;
+    }
+  }
+  prefetcher.run(pid);
+  prefetcher.report();
+  return 0;
+}
@@ -0,0 +1,312 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file cutOptimiser.h
+/// \brief Grid scan of rectangular cuts on cached candidates: signal efficiency vs trigger rate.
+///
+/// Candidates are signal (efficiency = fraction of the signal candidates passing the cuts) or
+/// background (rate = fraction of the inspected collisions with at least minCandidates passing
+/// candidates). The grid of each variable is placed at quantiles of its signal distribution
+/// (sorted once), from no cut down to minEfficiency. For every grid point the passing candidates
+/// are a bitset, built by sweeping the sorted values from the tightest to the loosest cut, so
+/// that a combination is the AND of one bitset per variable. The combinations are enumerated as
+/// an odometer that keeps the partial ANDs of the outer variables, so most of them cost a
+/// single AND over the candidates, and are split between threads.
+/// Background candidates must be added collision by collision.
+/// No O2 or ROOT dependency, so that the benchmark macros can use it.
+
+#ifndef O2_ANALYSIS_CUT_OPTIMISER_H_
+#define O2_ANALYSIS_CUT_OPTIMISER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace o2::filtering
+{
+
+struct CutVariable {
+  std::string name; // Configurable of the task
+  bool lowerCut;    // candidates pass with value > cut, otherwise with value < cut
+  bool integer;     // cut rounded to integers, towards looser
+};
+
+class CutOptimiser
+{
+ public:
+  struct Point {
+    std::vector<float> cuts;
+    double efficiency;
+    double rate;
+  };
+
+  explicit CutOptimiser(std::vector<CutVariable> variables) : mVariables(std::move(variables)), mSignal(mVariables.size()), mBackground(mVariables.size()) {}
+
+  /// values in the order of the variables; event: collision of a background candidate
+  void addCandidate(bool signal, uint64_t event, const float* values)
+  {
+    Sample& sample = signal ? mSignal : mBackground;
+    if (!signal) {
+      if (sample.events.empty() || event != mLastEvent) {
+        sample.events.push_back(sample.size);
+        mLastEvent = event;
+      }
+      sample.eventOf.push_back(sample.events.size() - 1);
+    }
+    for (size_t v = 0; v < mVariables.size(); v++) {
+      sample.values[v].push_back(values[v]);
+    }
+    sample.size++;
+  }
+
+  /// background collisions inspected by the trigger, with or without candidates
+  void setInspectedEvents(double n) { mInspected = n; }
+  /// collisions triggered with at least n passing candidates (2 for the double-Xi trigger)
+  void setMinCandidates(int n) { mMinCandidates = std::max(n, 1); }
+
+  /// grid of nSteps cuts per variable, from no cut down to minEfficiency of the signal alone
+  bool buildGrid(int nSteps, double minEfficiency)
+  {
+    if (!mSignal.size || !mBackground.size || nSteps < 1) {
+      return false;
+    }
+    mGrid.assign(mVariables.size(), {});
+    mSignal.bits.assign(mVariables.size(), {});
+    mBackground.bits.assign(mVariables.size(), {});
+    for (size_t v = 0; v < mVariables.size(); v++) {
+      std::vector<float> sorted = mSignal.values[v];
+      std::sort(sorted.begin(), sorted.end());
+      const int n = sorted.size();
+      for (int j = 0; j < nSteps; j++) {
+        double efficiency = nSteps > 1 ? 1. - j * (1. - minEfficiency) / (nSteps - 1) : 1.;
+        int kept = std::lround(efficiency * n);
+        float cut;
+        if (mVariables[v].lowerCut) {
+          int k = n - kept; // sorted[k..n) pass
+          cut = k ? sorted[k - 1] : std::nextafter(sorted[0], -std::numeric_limits<float>::infinity());
+          cut = mVariables[v].integer ? std::floor(cut) : cut;
+        } else {
+          cut = kept < n ? sorted[kept] : std::nextafter(sorted[n - 1], std::numeric_limits<float>::infinity());
+          cut = mVariables[v].integer ? std::ceil(cut) : cut;
+        }
+        if (mGrid[v].empty() || cut != mGrid[v].back()) {
+          mGrid[v].push_back(cut);
+        }
+      }
+      mSignal.bits[v] = passBits(mSignal.values[v], v);
+      mBackground.bits[v] = passBits(mBackground.values[v], v);
+    }
+    return true;
+  }
+
+  /// evaluates all the combinations of the grid
+  std::vector<Point> scan(int nThreads = 1)
+  {
+    long nCombinations = 1;
+    for (auto& grid : mGrid) {
+      nCombinations *= grid.size();
+    }
+    nThreads = std::max(1, int(std::min<long>(nThreads, nCombinations)));
+    std::vector<std::vector<Point>> results(nThreads);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < nThreads; t++) {
+      pool.emplace_back([this, t, nThreads, nCombinations, &results]() {
+        scanRange(nCombinations * t / nThreads, nCombinations * (t + 1) / nThreads, results[t]);
+      });
+    }
+    for (auto& thread : pool) {
+      thread.join();
+    }
+    std::vector<Point> points;
+    for (auto& result : results) {
+      points.insert(points.end(), result.begin(), result.end());
+    }
+    return points;
+  }
+
+  /// points with no other point of higher efficiency at lower or equal rate, by increasing rate
+  static std::vector<Point> paretoFront(std::vector<Point> points)
+  {
+    std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) {
+      return a.rate < b.rate || (a.rate == b.rate && a.efficiency > b.efficiency);
+    });
+    std::vector<Point> front;
+    for (auto& point : points) {
+      if (front.empty() || point.efficiency > front.back().efficiency) {
+        front.push_back(point);
+      }
+    }
+    return front;
+  }
+
+  /// efficiency (signal) and rate of a single set of cuts, candidate by candidate
+  Point evaluate(const std::vector<float>& cuts) const
+  {
+    auto passes = [&](const Sample& sample, size_t i) {
+      for (size_t v = 0; v < mVariables.size(); v++) {
+        float x = sample.values[v][i];
+        if (mVariables[v].lowerCut ? !(x > cuts[v]) : !(x < cuts[v])) {
+          return false;
+        }
+      }
+      return true;
+    };
+    long nSignal = 0, nTriggered = 0;
+    for (size_t i = 0; i < mSignal.size; i++) {
+      nSignal += passes(mSignal, i);
+    }
+    for (size_t e = 0; e < mBackground.events.size(); e++) {
+      size_t end = e + 1 < mBackground.events.size() ? mBackground.events[e + 1] : mBackground.size;
+      int n = 0;
+      for (size_t i = mBackground.events[e]; i < end; i++) {
+        n += passes(mBackground, i);
+      }
+      nTriggered += n >= mMinCandidates;
+    }
+    return {cuts, double(nSignal) / mSignal.size, nTriggered / inspected()};
+  }
+
+  const std::vector<CutVariable>& variables() const { return mVariables; }
+  const std::vector<std::vector<float>>& grid() const { return mGrid; }
+  size_t nSignal() const { return mSignal.size; }
+  size_t nBackground() const { return mBackground.size; }
+  size_t nBackgroundEvents() const { return mBackground.events.size(); }
+  double inspected() const { return mInspected > 0. ? mInspected : mBackground.events.size(); }
+
+ private:
+  using Bits = std::vector<uint64_t>;
+
+  struct Sample {
+    explicit Sample(size_t nVariables) : values(nVariables) {}
+    std::vector<std::vector<float>> values; // [variable][candidate]
+    std::vector<std::vector<Bits>> bits;    // [variable][grid point], passing candidates
+    std::vector<size_t> events;             // first candidate of each collision, background only
+    std::vector<uint32_t> eventOf;          // collision of each candidate, background only
+    size_t size = 0;
+  };
+
+  /// bitsets of the candidates passing each grid cut of variable v, tightest cut first
+  std::vector<Bits> passBits(const std::vector<float>& values, size_t v) const
+  {
+    const bool lower = mVariables[v].lowerCut;
+    std::vector<uint32_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    // most passing first: decreasing for lower cuts, increasing otherwise
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return lower ? values[a] > values[b] : values[a] < values[b]; });
+    const auto& grid = mGrid[v];
+    std::vector<Bits> bits(grid.size());
+    Bits current((values.size() + 63) / 64, 0);
+    size_t i = 0;
+    // the grid runs from the loosest to the tightest cut: fill from the tightest
+    for (int j = grid.size() - 1; j >= 0; j--) {
+      for (; i < order.size() && (lower ? values[order[i]] > grid[j] : values[order[i]] < grid[j]); i++) {
+        current[order[i] >> 6] |= uint64_t(1) << (order[i] & 63);
+      }
+      bits[j] = current;
+    }
+    return bits;
+  }
+
+  static void intersect(Bits& out, const Bits& a, const Bits& b)
+  {
+    const size_t n = out.size();
+    uint64_t* __restrict o = out.data();
+    const uint64_t* __restrict x = a.data();
+    const uint64_t* __restrict y = b.data();
+    for (size_t w = 0; w < n; w++) {
+      o[w] = x[w] & y[w];
+    }
+  }
+
+  static long count(const Bits& bits)
+  {
+    long n = 0;
+    for (uint64_t word : bits) {
+      n += __builtin_popcountll(word);
+    }
+    return n;
+  }
+
+  /// collisions with at least mMinCandidates set bits; candidates are stored collision by collision
+  long countEvents(const Bits& bits) const
+  {
+    const uint32_t* eventOf = mBackground.eventOf.data();
+    long nTriggered = 0;
+    uint32_t event = std::numeric_limits<uint32_t>::max();
+    int n = 0;
+    for (size_t w = 0; w < bits.size(); w++) {
+      for (uint64_t word = bits[w]; word; word &= word - 1) {
+        uint32_t e = eventOf[(w << 6) + __builtin_ctzll(word)];
+        n = e == event ? n + 1 : 1;
+        event = e;
+        nTriggered += n == mMinCandidates;
+      }
+    }
+    return nTriggered;
+  }
+
+  /// combinations [first, last) of the odometer, the last variable running fastest
+  void scanRange(long first, long last, std::vector<Point>& points) const
+  {
+    const size_t nVariables = mVariables.size();
+    if (first >= last || !nVariables) {
+      return;
+    }
+    std::vector<size_t> index(nVariables);
+    for (long c = first, v = nVariables - 1; v >= 0; v--) {
+      index[v] = c % mGrid[v].size();
+      c /= mGrid[v].size();
+    }
+    // partial[v]: AND of the bitsets of the variables 0..v
+    std::vector<Bits> signal(nVariables, Bits(mSignal.bits[0][0].size())), background(nVariables, Bits(mBackground.bits[0][0].size()));
+    size_t valid = 0; // partial ANDs valid below this variable
+    const double nSignal = mSignal.size, nInspected = inspected();
+    for (long c = first; c < last; c++) {
+      for (size_t v = valid; v < nVariables; v++) {
+        if (v == 0) {
+          signal[0] = mSignal.bits[0][index[0]];
+          background[0] = mBackground.bits[0][index[0]];
+        } else {
+          intersect(signal[v], signal[v - 1], mSignal.bits[v][index[v]]);
+          intersect(background[v], background[v - 1], mBackground.bits[v][index[v]]);
+        }
+      }
+      Point point{std::vector<float>(nVariables), count(signal[nVariables - 1]) / nSignal, countEvents(background[nVariables - 1]) / nInspected};
+      for (size_t v = 0; v < nVariables; v++) {
+        point.cuts[v] = mGrid[v][index[v]];
+      }
+      points.push_back(std::move(point));
+      // next combination: the partial ANDs of the variables before the first changed one stay valid
+      size_t v = nVariables - 1;
+      while (++index[v] == mGrid[v].size() && v > 0) {
+        index[v--] = 0;
+      }
+      valid = v;
+    }
+  }
+
+  std::vector<CutVariable> mVariables;
+  std::vector<std::vector<float>> mGrid; // [variable], from the loosest to the tightest cut
+  Sample mSignal, mBackground;
+  uint64_t mLastEvent = 0;
+  double mInspected = 0.;
+  int mMinCandidates = 1;
+};
+
+} // namespace o2::filtering
+
+#endif // O2_ANALYSIS_CUT_OPTIMISER_H_
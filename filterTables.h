@@ -13,6 +13,7 @@
 
 #include <array>
 #include "Framework/AnalysisDataModel.h"
+#include "Common/DataModel/StrangenessTables.h"
 
 namespace o2::aod
 {
@@ -38,6 +39,29 @@ DECLARE_SOA_COLUMN(DoubleXi, hasDoubleXi, bool); //! at least 2 Xi
 DECLARE_SOA_COLUMN(TripleXi, hasTripleXi, bool); //! at least 3 Xi
 DECLARE_SOA_COLUMN(QuadrupleXi, hasQuadrupleXi, bool); //! at least 4 Xi
 
+// sparse decisions: only collisions with at least one trigger bit set
+DECLARE_SOA_INDEX_COLUMN(Collision, collision);       //! triggered collision
+DECLARE_SOA_COLUMN(Decisions, decisions, uint32_t);   //! bit i = i-th column of the dense table
+DECLARE_SOA_COLUMN(RunNumber, runNumber, int);        //!
+DECLARE_SOA_COLUMN(NInspected, nInspected, uint64_t); //! collisions inspected by the filter, for the normalisation
+
+// event selection of the strangeness tasks, materialised so that it can be used in a collision Filter
+DECLARE_SOA_COLUMN(EvSelLevel, evSelLevel, int); //! see StrangenessEvSelLevel
+
+// Xi candidates after the preselection of the strangeness filter, input of the cut optimiser
+DECLARE_SOA_INDEX_COLUMN_FULL(CascData, cascData, int, CascData, ""); //!
+DECLARE_SOA_COLUMN(CascCosPA, cascCosPA, float);                       //!
+DECLARE_SOA_COLUMN(DCAV0ToPV, dcaV0ToPV, float);                       //!
+DECLARE_SOA_COLUMN(DMassXi, dMassXi, float);                           //! |m - m_PDG| (GeV/c^2)
+DECLARE_SOA_COLUMN(LifetimeXi, lifetimeXi, float);                     //! m L / p in units of the Xi c tau
+DECLARE_SOA_COLUMN(IsSignal, isSignal, bool);                          //! matched to a generated Xi
+
+// downscale adjustments of the trigger-rate controller
+DECLARE_SOA_COLUMN(GlobalBC, globalBC, uint64_t); //! first BC with the new downscale
+DECLARE_SOA_COLUMN(TriggerBit, triggerBit, int);  //! bit of the decision word
+DECLARE_SOA_COLUMN(RawRate, rawRate, float);      //! accept rate before the downscale over the window (Hz)
+DECLARE_SOA_COLUMN(Downscale, downscale, float);  //! one in downscale triggered collisions kept from globalBC on
+
 } // namespace filtering
 
 // nuclei
@@ -62,6 +86,47 @@ DECLARE_SOA_TABLE(StrangenessFilters, "AOD", "StrgFilters", //!
 
 using StrangenessFilter = StrangenessFilters::iterator;
 
+DECLARE_SOA_TABLE(StrangenessSparseFilters, "AOD", "StrgSparseFlt", //! triggered collisions of StrangenessFilters
+                  filtering::CollisionId, filtering::Decisions);
+DECLARE_SOA_TABLE(StrangenessSparseFiltersK0s, "AOD", "StrgSparseK0s", //! triggered collisions of the K0s filter
+                  filtering::CollisionId, filtering::Decisions);
+DECLARE_SOA_TABLE(StrangenessFilterSummaries, "AOD", "StrgFltSummary", //! one row per data frame, to be summed per run
+                  filtering::RunNumber, filtering::NInspected);
+DECLARE_SOA_TABLE(StrangenessFilterSummariesK0s, "AOD", "StrgK0sSummary", //! one row per data frame, to be summed per run
+                  filtering::RunNumber, filtering::NInspected);
+
+DECLARE_SOA_TABLE(StrangenessEvSels, "AOD", "StrgEvSel", //! one row per collision, joinable with Collisions
+                  filtering::EvSelLevel);
+using StrangenessEvSel = StrangenessEvSels::iterator;
+
+DECLARE_SOA_TABLE(StrangenessCutCands, "AOD", "StrgCutCand", //! Xi candidates of the filter, for strangeness-cut-optimiser
+                  filtering::CollisionId, filtering::CascDataId, filtering::CascCosPA, filtering::DCAV0ToPV, filtering::DMassXi, filtering::LifetimeXi);
+using StrangenessCutCand = StrangenessCutCands::iterator;
+DECLARE_SOA_TABLE(StrangenessCutCandLabels, "AOD", "StrgCutCandLbl", //! MC truth of StrangenessCutCands, joinable
+                  filtering::IsSignal);
+
+DECLARE_SOA_TABLE(StrangenessRateControls, "AOD", "StrgRateCtrl", //! one row per downscale change of the strangeness filter
+                  filtering::RunNumber, filtering::GlobalBC, filtering::TriggerBit, filtering::RawRate, filtering::Downscale);
+
+/// levels of the strangeness event selection, each one includes the previous ones
+enum StrangenessEvSelLevel {
+  kEvSelNone = 0, // rejected
+  kEvSelINT7,     // kINT7 alias
+  kEvSelINT7Sel7  // kINT7 alias and sel7
+};
+
+/// packed decision word of the sparse tables
+template <std::size_t N>
+uint32_t PackDecisions(const bool (&decisions)[N])
+{
+  static_assert(N <= 32, "too many triggers for the decision word");
+  uint32_t word = 0;
+  for (std::size_t i = 0; i < N; i++) {
+    word |= uint32_t(decisions[i]) << i;
+  }
+  return word;
+}
+
 /// List of the available filters, the description of their tables and the name of the tasks
 constexpr int NumberOfFilters{4};
 constexpr std::array<char[32], NumberOfFilters> AvailableFilters{"NucleiFilters", "DiffractionFilters", "HeavyFlavourFilters", "StrangenessFilters"};
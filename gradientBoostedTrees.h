@@ -0,0 +1,363 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file gradientBoostedTrees.h
+/// \brief Gradient-boosted decision trees compiled into flat node arrays, for batched inference.
+///
+/// The model is read from the text dump of an XGBoost booster (Booster.dump_model, with the
+/// feature names of the task or f<index>), optionally preceded by "base_score=<value>" and
+/// "objective=<name>" lines.
+/// Single candidates walk the trees, renumbered breadth-first so that the two children of a
+/// node are adjacent: a node moves to left + (x >= threshold) until a leaf, marked by feature -1,
+/// and at most for the depth of the tree.
+/// Batches are evaluated kLanes candidates at a time with SIMD vectors and no walk: the leaves
+/// of a tree are numbered left to right and every node with x >= threshold clears the leaves of
+/// its "yes" subtree from a bitmask; the exit leaf is the lowest bit left (QuickScorer). A tree
+/// costs one compare and one and-not per node, on the contiguous feature values of the batch.
+/// Trees with more than 32 leaves are walked in the batches too.
+/// Missing values are not supported: NaN features follow the "yes" branch.
+/// No O2 or ROOT dependency, so that the benchmark macros can use it.
+
+#ifndef O2_ANALYSIS_GRADIENT_BOOSTED_TREES_H_
+#define O2_ANALYSIS_GRADIENT_BOOSTED_TREES_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace o2::filtering
+{
+
+class GradientBoostedTrees
+{
+ public:
+  struct Node {
+    float threshold; // unused for the leaves
+    int32_t feature; // kLeaf for the leaves
+    int32_t left;    // global index of the "yes" (x < threshold) child, right child at left + 1; self for the leaves
+  };
+
+  static constexpr int32_t kLeaf = -1;    // feature of the leaf nodes, ends the walk
+  static constexpr int kLanes = 4;        // candidates per SIMD vector
+  static constexpr int kChunkVectors = 8; // vectors evaluated together, each node is read once for all
+
+  GradientBoostedTrees() = default;
+  explicit GradientBoostedTrees(std::vector<std::string> featureNames) : mFeatureNames(std::move(featureNames)) {}
+
+  /// adds a tree from parallel arrays indexed by the node id of the model: feature < 0 marks a
+  /// leaf with the given value, otherwise the node sends x < threshold to yes and the rest to no
+  bool addTree(const std::vector<int>& feature, const std::vector<float>& threshold, const std::vector<int>& yes,
+               const std::vector<int>& no, const std::vector<float>& value)
+  {
+    const int n = feature.size();
+    if (!n) {
+      return false;
+    }
+    // breadth first from the root, children of a node consecutive
+    std::vector<int> order{0}, newId(n, -1);
+    newId[0] = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+      int id = order[i];
+      if (feature[id] < 0) {
+        continue;
+      }
+      for (int child : {yes[id], no[id]}) {
+        if (child <= 0 || child >= n || newId[child] >= 0) {
+          return false;
+        }
+        newId[child] = order.size();
+        order.push_back(child);
+      }
+    }
+    const int32_t offset = mNodes.size();
+    int depth = 0;
+    std::vector<int> nodeDepth(order.size(), 0);
+    for (size_t i = 0; i < order.size(); i++) {
+      int id = order[i];
+      Node node;
+      if (feature[id] < 0) {
+        node = {0.f, kLeaf, offset + int32_t(i)};
+        mValues.push_back(value[id]);
+      } else {
+        if (feature[id] >= int(nFeatures())) {
+          mNodes.resize(offset);
+          mValues.resize(offset);
+          return false;
+        }
+        node = {threshold[id], feature[id], offset + newId[yes[id]]};
+        mValues.push_back(0.f);
+        nodeDepth[newId[yes[id]]] = nodeDepth[newId[no[id]]] = nodeDepth[i] + 1;
+        depth = std::max(depth, nodeDepth[i] + 1);
+      }
+      mNodes.push_back(node);
+    }
+    mRoots.push_back(offset);
+    mDepths.push_back(depth);
+    addMaskTree(feature, threshold, yes, no, value);
+    return true;
+  }
+
+  /// reads an XGBoost text dump, see the file description
+  bool read(const std::string& fileName)
+  {
+    std::ifstream in(fileName);
+    if (!in) {
+      return false;
+    }
+    clear();
+    std::map<std::string, int> featureIndex;
+    for (size_t f = 0; f < mFeatureNames.size(); f++) {
+      featureIndex[mFeatureNames[f]] = f;
+    }
+    std::vector<int> feature, yes, no;
+    std::vector<float> threshold, value;
+    auto flush = [&]() {
+      bool ok = feature.empty() || addTree(feature, threshold, yes, no, value);
+      feature.clear(), yes.clear(), no.clear(), threshold.clear(), value.clear();
+      return ok;
+    };
+    std::string line;
+    while (std::getline(in, line)) {
+      line.erase(0, line.find_first_not_of(" \t"));
+      if (line.empty()) {
+        continue;
+      }
+      if (line.compare(0, 11, "base_score=") == 0) {
+        mBaseScore = std::stof(line.substr(11));
+        continue;
+      }
+      if (line.compare(0, 10, "objective=") == 0) {
+        mLogistic = line.find("logistic") != std::string::npos;
+        continue;
+      }
+      if (line.compare(0, 7, "booster") == 0) {
+        if (!flush()) {
+          return false;
+        }
+        continue;
+      }
+      // <id>:leaf=<value> or <id>:[<feature><<threshold>] yes=<id>,no=<id>,missing=<id>[,gain=...]
+      size_t colon = line.find(':');
+      if (colon == std::string::npos) {
+        return false;
+      }
+      int id = std::stoi(line.substr(0, colon));
+      if (id >= int(feature.size())) {
+        feature.resize(id + 1, -1), yes.resize(id + 1, -1), no.resize(id + 1, -1);
+        threshold.resize(id + 1, 0.f), value.resize(id + 1, 0.f);
+      }
+      if (line.compare(colon + 1, 5, "leaf=") == 0) {
+        value[id] = std::stof(line.substr(colon + 6));
+        continue;
+      }
+      size_t open = line.find('[', colon), less = line.find('<', colon), close = line.find(']', colon);
+      size_t y = line.find("yes=", close), n = line.find("no=", close);
+      if (open == std::string::npos || less == std::string::npos || close == std::string::npos || y == std::string::npos || n == std::string::npos) {
+        return false;
+      }
+      std::string name = line.substr(open + 1, less - open - 1);
+      auto it = featureIndex.find(name);
+      if (it != featureIndex.end()) {
+        feature[id] = it->second;
+      } else if (name.size() > 1 && name[0] == 'f' && name.find_first_not_of("0123456789", 1) == std::string::npos) {
+        feature[id] = std::stoi(name.substr(1));
+      } else {
+        return false;
+      }
+      threshold[id] = std::stof(line.substr(less + 1, close - less - 1));
+      yes[id] = std::stoi(line.substr(y + 4));
+      no[id] = std::stoi(line.substr(n + 3));
+    }
+    return flush() && !mRoots.empty();
+  }
+
+  void clear()
+  {
+    mNodes.clear();
+    mValues.clear();
+    mRoots.clear();
+    mDepths.clear();
+    mMaskNodes.clear();
+    mLeafValues.clear();
+    mMaskTrees.clear();
+    mWalkedTrees.clear();
+    mNUsedFeatures = 0;
+  }
+
+  /// margins (sum of the leaves plus the base margin) of n candidates; features[f] points to
+  /// the n values of feature f
+  void predict(int n, const float* const* features, float* margins) const
+  {
+    const float base = baseMargin();
+    // the last incomplete vector reads a copy of its candidates, zeros in the missing lanes
+    const int nFull = n / kLanes;
+    std::vector<FloatVector> tail(n > nFull * kLanes ? mNUsedFeatures : 0);
+    for (size_t f = 0; f < tail.size(); f++) {
+      tail[f] = FloatVector{};
+      for (int l = 0; l < n - nFull * kLanes; l++) {
+        tail[f][l] = features[f][nFull * kLanes + l];
+      }
+    }
+    MaskVector mask[kChunkVectors];
+    FloatVector margin[kChunkVectors];
+    for (int first = 0; first < nFull + int(!tail.empty()); first += kChunkVectors) {
+      const int nVectors = std::min(kChunkVectors, nFull + int(!tail.empty()) - first);
+      const int nLoaded = std::min(nVectors, nFull - first); // the others are the tail
+      for (int v = 0; v < nVectors; v++) {
+        margin[v] = FloatVector{} + base;
+      }
+      for (const auto& tree : mMaskTrees) {
+        for (int v = 0; v < nVectors; v++) {
+          mask[v] = ~MaskVector{};
+        }
+        for (int k = tree.firstNode; k < tree.lastNode; k++) {
+          const MaskNode& nd = mMaskNodes[k];
+          const float* values = features[nd.feature] + first * kLanes;
+          for (int v = 0; v < nLoaded; v++) {
+            FloatVector x;
+            std::memcpy(&x, values + v * kLanes, sizeof(x));
+            mask[v] &= ~((MaskVector)(x >= nd.threshold) & nd.yesLeaves);
+          }
+          if (nLoaded < nVectors) {
+            mask[nLoaded] &= ~((MaskVector)(tail[nd.feature] >= nd.threshold) & nd.yesLeaves);
+          }
+        }
+        const float* leaves = mLeafValues.data() + tree.firstLeaf;
+        for (int v = 0; v < nVectors; v++) {
+          for (int l = 0; l < kLanes; l++) {
+            margin[v][l] += leaves[__builtin_ctz(mask[v][l])];
+          }
+        }
+      }
+      std::copy_n(reinterpret_cast<const float*>(margin), std::min(nVectors * kLanes, n - first * kLanes), margins + first * kLanes);
+    }
+    // trees too large for the masks, all the candidates walk them together one level at a time
+    if (!mWalkedTrees.empty()) {
+      std::vector<int32_t> node(n);
+      for (size_t t : mWalkedTrees) {
+        for (int i = 0; i < n; i++) {
+          node[i] = mRoots[t];
+        }
+        for (int d = 0; d < mDepths[t]; d++) {
+          for (int i = 0; i < n; i++) {
+            const Node& nd = mNodes[node[i]];
+            if (nd.feature != kLeaf) {
+              node[i] = nd.left + (features[nd.feature][i] >= nd.threshold);
+            }
+          }
+        }
+        for (int i = 0; i < n; i++) {
+          margins[i] += mValues[node[i]];
+        }
+      }
+    }
+  }
+
+  /// margin of a single candidate, features in the order of the feature names
+  float predict(const float* features) const
+  {
+    float margin = baseMargin();
+    for (size_t t = 0; t < mRoots.size(); t++) {
+      int32_t node = mRoots[t];
+      for (int d = 0; d < mDepths[t] && mNodes[node].feature != kLeaf; d++) {
+        node = mNodes[node].left + (features[mNodes[node].feature] >= mNodes[node].threshold);
+      }
+      margin += mValues[node];
+    }
+    return margin;
+  }
+
+  /// probability for a binary:logistic model, the margin otherwise
+  float response(float margin) const { return mLogistic ? 1.f / (1.f + std::exp(-margin)) : margin; }
+
+  size_t nFeatures() const { return mFeatureNames.empty() ? std::numeric_limits<int32_t>::max() : mFeatureNames.size(); }
+  size_t nTrees() const { return mRoots.size(); }
+  size_t nNodes() const { return mNodes.size(); }
+  const std::vector<std::string>& featureNames() const { return mFeatureNames; }
+
+ private:
+  typedef float FloatVector __attribute__((vector_size(kLanes * sizeof(float))));
+  typedef uint32_t MaskVector __attribute__((vector_size(kLanes * sizeof(uint32_t))));
+
+  struct MaskNode {
+    float threshold;
+    int32_t feature;
+    uint32_t yesLeaves; // leaves of the "yes" subtree, cleared when x >= threshold
+  };
+  struct MaskTree {
+    int32_t firstNode, lastNode; // in mMaskNodes
+    int32_t firstLeaf;           // in mLeafValues, left to right
+  };
+
+  /// leaves numbered left to right ("yes" first); a tree with more than 32 leaves is walked
+  void addMaskTree(const std::vector<int>& feature, const std::vector<float>& threshold, const std::vector<int>& yes,
+                   const std::vector<int>& no, const std::vector<float>& value)
+  {
+    const int32_t firstNode = mMaskNodes.size(), firstLeaf = mLeafValues.size();
+    int nLeaves = 0;
+    bool tooLarge = false;
+    // returns the leaves of the subtree of id
+    auto visit = [&](auto& self, int id) -> uint32_t {
+      if (feature[id] < 0) {
+        if (nLeaves == 32) {
+          tooLarge = true;
+          return 0;
+        }
+        mLeafValues.push_back(value[id]);
+        return uint32_t(1) << nLeaves++;
+      }
+      const size_t k = mMaskNodes.size();
+      mMaskNodes.push_back({threshold[id], feature[id], 0});
+      mNUsedFeatures = std::max(mNUsedFeatures, feature[id] + 1);
+      const uint32_t yesLeaves = self(self, yes[id]);
+      mMaskNodes[k].yesLeaves = yesLeaves;
+      return yesLeaves | self(self, no[id]);
+    };
+    visit(visit, 0);
+    if (tooLarge) {
+      mMaskNodes.resize(firstNode);
+      mLeafValues.resize(firstLeaf);
+      mWalkedTrees.push_back(mRoots.size() - 1);
+      for (int id = 0; id < int(feature.size()); id++) {
+        mNUsedFeatures = std::max(mNUsedFeatures, feature[id] + 1);
+      }
+      return;
+    }
+    mMaskTrees.push_back({firstNode, int32_t(mMaskNodes.size()), firstLeaf});
+  }
+
+  /// base_score is a probability for the logistic objective, the margin is its logit
+  float baseMargin() const { return mLogistic ? std::log(mBaseScore / (1.f - mBaseScore)) : mBaseScore; }
+
+  std::vector<std::string> mFeatureNames;
+  std::vector<Node> mNodes;   // all the trees, each breadth first
+  std::vector<float> mValues; // leaf values, 0 for the internal nodes
+  std::vector<int32_t> mRoots;
+  std::vector<int> mDepths;
+  std::vector<MaskNode> mMaskNodes;  // all the trees of the batch evaluation, depth first
+  std::vector<float> mLeafValues;    // per tree, left to right
+  std::vector<MaskTree> mMaskTrees;
+  std::vector<size_t> mWalkedTrees;  // trees with more than 32 leaves
+  int mNUsedFeatures = 0;            // highest feature index + 1
+  float mBaseScore = 0.5f;
+  bool mLogistic = true;
+};
+
+} // namespace o2::filtering
+
+#endif // O2_ANALYSIS_GRADIENT_BOOSTED_TREES_H_
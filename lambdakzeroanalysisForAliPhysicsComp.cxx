@@ -24,6 +24,7 @@
 
 //o2-analysis-timestamp --aod-file AO2D_17p_pass1_FAST_AOD234_001To5.root -b |
 //o2-analysis-event-selection -b |
+//o2-analysis-strangeness-event-selection -b |
 //o2-analysis-multiplicity-table -b |
 //o2-analysis-centrality-table -b |
 //o2-analysis-pid-tof -b |
@@ -59,11 +60,41 @@
 #include <cstdlib>
 #include "Framework/ASoAHelpers.h"
 
+#include "../filterTables.h"
+
 using namespace o2;
 using namespace o2::framework;
 using namespace o2::framework::expressions;
 using std::array;
 
+namespace o2::aod
+{
+namespace v0topology
+{
+DECLARE_SOA_COLUMN(CosPA, cosPA, double);                  //! V0 cosine of pointing angle w.r.t. its own collision vertex
+DECLARE_SOA_COLUMN(Radius, radius, float);                 //! V0 decay radius (cm)
+DECLARE_SOA_COLUMN(DistOverTotMom, distOverTotMom, float); //! V0 decay length over total momentum, L/p
+} // namespace v0topology
+DECLARE_SOA_TABLE(V0Topologies, "AOD", "V0TOPOLOGY", //! Topological variables of V0Datas, row-aligned with it
+                  v0topology::CosPA, v0topology::Radius, v0topology::DistOverTotMom);
+} // namespace o2::aod
+
+// Materialises the V0 topological variables (dynamic columns of V0Datas) so that
+// they can be used in Filter expressions downstream
+struct lambdakzerotopology {
+  Produces<aod::V0Topologies> v0topology;
+
+  void process(aod::Collisions const&, aod::V0Datas const& fullV0s)
+  {
+    for (auto& v0 : fullV0s) {
+      auto collision = v0.collision();
+      v0topology(v0.v0cosPA(collision.posX(), collision.posY(), collision.posZ()),
+                 v0.v0radius(),
+                 v0.distovertotmom(collision.posX(), collision.posY(), collision.posZ()));
+    }
+  }
+};
+
 struct lambdakzeroQA {
   //Basic checks
   HistogramRegistry registry{
@@ -80,22 +111,42 @@ struct lambdakzeroQA {
     },
   };
 
-  OutputObj<TH1F> henum{TH1F("henum", "Event counter", 4, 0., 4.)};
+  OutputObj<TH1F> henum{TH1F("henum", "Event counter", 5, 0., 5.)};
   OutputObj<TH1F> hvertexZ{TH1F("hvertexZ", "Z vertex", 400, -20., 20.)};
   OutputObj<TH1F> hMult{TH1F("hMult", "Multiplicity distribution", 100, 0., 100.)};
   Configurable<float> cutzvertex{"cutzvertex", 10.0f, "Accepted z-vertex range"};
 
+  // Sampling: the QA is filled for a deterministic fraction of the collisions and, within a
+  // collision, for at most qaMaxV0s V0s chosen at random. Histograms are weighted by the
+  // inverse of the sampling probabilities so that they keep the normalisation of the full QA.
+  // The collision decision is keyed on run number and global BC, not on the index in the data
+  // frame, so the same collisions are sampled whatever the splitting of the input
+  Configurable<float> qaSamplingFraction{"qaSamplingFraction", 1.0f, "Fraction of collisions used for the V0 QA"};
+  Configurable<int> qaMaxV0s{"qaMaxV0s", -1, "Max number of V0s per collision used for the QA (-1: all)"};
+  Configurable<int> qaSamplingSeed{"qaSamplingSeed", 0, "Seed of the collision and V0 sampling"};
+
   void init(InitContext const&)
   {
     henum->GetXaxis()->SetBinLabel(1, "All events");
     henum->GetXaxis()->SetBinLabel(2, "kINT7");
     henum->GetXaxis()->SetBinLabel(3, "|Zvtx|<10 cm");
     henum->GetXaxis()->SetBinLabel(4, "sel7");
+    henum->GetXaxis()->SetBinLabel(5, "Sampled");
   }
 
+  // splitmix64 finaliser: reproducible and uniformly distributed pseudo-random numbers
+  static uint64_t hashIndex(uint64_t x)
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+  static double toUnit(uint64_t x) { return (x >> 11) * (1.0 / 9007199254740992.0); }
+
   using CollisionCandidates = soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms>::iterator;
-  
-  void process(CollisionCandidates const& collision, aod::V0Datas const& fullV0s)
+
+  void processQA(CollisionCandidates const& collision, aod::V0Datas const& fullV0s, aod::BCs const&)
   {
 
     henum->Fill(0.5);
@@ -114,18 +165,53 @@ struct lambdakzeroQA {
     hvertexZ->Fill(collision.posZ());
     hMult->Fill(collision.centV0M());
 
+    auto bc = collision.bc();
+    uint64_t state = hashIndex(bc.globalBC() ^ hashIndex((uint64_t(bc.runNumber()) << 32) | uint32_t(qaSamplingSeed)));
+    if (qaSamplingFraction < 1.f && toUnit(state) >= qaSamplingFraction) {
+      return;
+    }
+    henum->Fill(4.5);
+
+    // selection sampling: each V0 is kept with probability (needed / remaining), which
+    // picks exactly qaMaxV0s of them uniformly in a single pass
+    int nV0s = fullV0s.size();
+    int needed = (qaMaxV0s >= 0 && qaMaxV0s < nV0s) ? static_cast<int>(qaMaxV0s) : nV0s;
+    if (needed == 0) {
+      return;
+    }
+    double weight = static_cast<double>(nV0s) / needed;
+    if (qaSamplingFraction < 1.f) {
+      weight /= qaSamplingFraction;
+    }
+
+    int remaining = nV0s;
     for (auto& v0 : fullV0s) {
-      registry.fill(HIST("hMassK0Short"), v0.mK0Short());
-      registry.fill(HIST("hMassLambda"), v0.mLambda());
-      registry.fill(HIST("hMassAntiLambda"), v0.mAntiLambda());
-
-      registry.fill(HIST("hV0Radius"), v0.v0radius());
-      registry.fill(HIST("hV0CosPA"), v0.v0cosPA(collision.posX(), collision.posY(), collision.posZ()));
-      registry.fill(HIST("hDCAPosToPV"), v0.dcapostopv());
-      registry.fill(HIST("hDCANegToPV"), v0.dcanegtopv());
-      registry.fill(HIST("hDCAV0Dau"), v0.dcaV0daughters());
+      if (needed < remaining) {
+        state = hashIndex(state);
+        if (toUnit(state) * remaining >= needed) {
+          remaining--;
+          continue;
+        }
+      }
+      needed--;
+      remaining--;
+
+      registry.fill(HIST("hMassK0Short"), v0.mK0Short(), weight);
+      registry.fill(HIST("hMassLambda"), v0.mLambda(), weight);
+      registry.fill(HIST("hMassAntiLambda"), v0.mAntiLambda(), weight);
+
+      registry.fill(HIST("hV0Radius"), v0.v0radius(), weight);
+      registry.fill(HIST("hV0CosPA"), v0.v0cosPA(collision.posX(), collision.posY(), collision.posZ()), weight);
+      registry.fill(HIST("hDCAPosToPV"), v0.dcapostopv(), weight);
+      registry.fill(HIST("hDCANegToPV"), v0.dcanegtopv(), weight);
+      registry.fill(HIST("hDCAV0Dau"), v0.dcaV0daughters(), weight);
+
+      if (needed == 0) {
+        break;
+      }
     }
   }
+  PROCESS_SWITCH(lambdakzeroQA, processQA, "Fill the V0 QA histograms", true);
 };
 
 struct lambdakzeroanalysis {
@@ -134,25 +220,31 @@ struct lambdakzeroanalysis {
     "registry",
     {
       {"henumBis", "henumBis", {HistType::kTH1F, {{3,0.0f,3.0f}}}},
-      {"h3dMassK0Short", "h3dMassK0Short", {HistType::kTH3F, {{20, 0.0f, 100.0f}, {200, 0.0f, 10.0f}, {200, 0.450f, 0.550f}}}},
-      {"h3dMassLambda", "h3dMassLambda", {HistType::kTH3F, {{20, 0.0f, 100.0f}, {200, 0.0f, 10.0f}, {200, 1.015f, 1.215f}}}},
-      {"h3dMassAntiLambda", "h3dMassAntiLambda", {HistType::kTH3F, {{20, 0.0f, 100.0f}, {200, 0.0f, 10.0f}, {200, 1.015f, 1.215f}}}},
     },
   };
 
   ConfigurableAxis dcaBinning{"dca-binning", {200, 0.0f, 1.0f}, ""};
   ConfigurableAxis ptBinning{"pt-binning", {200, 0.0f, 10.0f}, ""};
+  // THnSparseF only allocates the bins that are filled (mostly around the mass peaks) and
+  // merges sparse-to-sparse; use ConvertSparseToTH3.C to get the usual TH3 from the output
+  Configurable<bool> useSparseHists{"useSparseHists", false, "Book the 3D mass histograms as THnSparseF"};
 
   void init(InitContext const&)
   {
+    AxisSpec centAxis = {20, 0.0f, 100.0f};
     AxisSpec dcaAxis = {dcaBinning, "DCA (cm)"};
     AxisSpec ptAxis = {ptBinning, "#it{p}_{T} (GeV/c)"};
     AxisSpec massAxisK0Short = {200, 0.450f, 0.550f, "Inv. Mass (GeV)"};
     AxisSpec massAxisLambda = {200, 1.015f, 1.215f, "Inv. Mass (GeV)"};
+    HistType massHistType = useSparseHists ? HistType::kTHnSparseF : HistType::kTH3F;
+
+    registry.add("h3dMassK0Short", "h3dMassK0Short", {massHistType, {centAxis, {200, 0.0f, 10.0f}, massAxisK0Short}});
+    registry.add("h3dMassLambda", "h3dMassLambda", {massHistType, {centAxis, {200, 0.0f, 10.0f}, massAxisLambda}});
+    registry.add("h3dMassAntiLambda", "h3dMassAntiLambda", {massHistType, {centAxis, {200, 0.0f, 10.0f}, massAxisLambda}});
 
-    registry.add("h3dMassK0ShortDca", "h3dMassK0ShortDca", {HistType::kTH3F, {dcaAxis, ptAxis, massAxisK0Short}});
-    registry.add("h3dMassLambdaDca", "h3dMassLambdaDca", {HistType::kTH3F, {dcaAxis, ptAxis, massAxisLambda}});
-    registry.add("h3dMassAntiLambdaDca", "h3dMassAntiLambdaDca", {HistType::kTH3F, {dcaAxis, ptAxis, massAxisLambda}});
+    registry.add("h3dMassK0ShortDca", "h3dMassK0ShortDca", {massHistType, {dcaAxis, ptAxis, massAxisK0Short}});
+    registry.add("h3dMassLambdaDca", "h3dMassLambdaDca", {massHistType, {dcaAxis, ptAxis, massAxisLambda}});
+    registry.add("h3dMassAntiLambdaDca", "h3dMassAntiLambdaDca", {massHistType, {dcaAxis, ptAxis, massAxisLambda}});
   }
 
   //Selection criteria
@@ -168,42 +260,56 @@ struct lambdakzeroanalysis {
   Configurable<LabeledArray<float>> lifetimecut{"lifetimecut", {defaultLifetimeCuts[0], 2, {"lifetimecutLambda", "lifetimecutK0S"}}, "lifetimecut"};
 
   Configurable<float> cutzvertex{"cutzvertex", 10.0f, "Accepted z-vertex range"};
+  Configurable<int> minEvSelLevel{"minEvSelLevel", aod::kEvSelINT7, "Min StrangenessEvSelLevel in the collision Filter (0: selection in process, for timing comparisons)"};
+
+  // rejected collisions are not grouped with the V0s: henumBis is filled by processCounts,
+  // on all the collisions
+  Filter eventSelFilter = aod::filtering::evSelLevel >= minEvSelLevel;
   Filter preFilterV0 = nabs(aod::v0data::dcapostopv) > dcapostopv&& nabs(aod::v0data::dcanegtopv) > dcanegtopv&& aod::v0data::dcaV0daughters < dcav0dau;
+  Filter topologyFilterV0 = aod::v0topology::radius > v0radius&& aod::v0topology::cosPA > v0cospa;
+
+  using V0Candidates = soa::Filtered<soa::Join<aod::V0Datas, aod::V0Topologies>>;
 
+  using CollisionCandidates = soa::Filtered<soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms, aod::StrangenessEvSels>>::iterator;
 
-  void process(soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms>::iterator const& collision, soa::Filtered<aod::V0Datas> const& fullV0s)
+  //Collision counts of henumBis, unfiltered so that they do not depend on minEvSelLevel
+  void processCounts(soa::Join<aod::Collisions, aod::StrangenessEvSels>::iterator const& collision)
+  {
+    registry.fill(HIST("henumBis"), 0.5);
+    if (TMath::Abs(collision.posZ()) >= cutzvertex) {
+      return;
+    }
+    registry.fill(HIST("henumBis"), 1.5);
+    if (collision.evSelLevel() >= aod::kEvSelINT7) {
+      registry.fill(HIST("henumBis"), 2.5);
+    }
+  }
+  PROCESS_SWITCH(lambdakzeroanalysis, processCounts, "Count all the collisions in henumBis, before the collision Filter", true);
+
+  void process(CollisionCandidates const& collision, V0Candidates const& fullV0s)
     {
-    registry.fill(HIST("henumBis"),0.5);
     if (TMath::Abs(collision.posZ()) >= cutzvertex){
       return;
     }
-    registry.fill(HIST("henumBis"),1.5);
-    if (!collision.alias()[kINT7]) {
+    if (collision.evSelLevel() < aod::kEvSelINT7) {
       return;
     }
-    if (!collision.sel7()) {
-      //      return;
-    }
-    registry.fill(HIST("henumBis"),2.5);
     for (auto& v0 : fullV0s) {
-      //FIXME: could not find out how to filter cosPA and radius variables (dynamic columns)
-      if (v0.v0radius() > v0radius && v0.v0cosPA(collision.posX(), collision.posY(), collision.posZ()) > v0cospa) {
-        if (TMath::Abs(v0.yLambda()) < rapidity) {
-          if (v0.distovertotmom(collision.posX(), collision.posY(), collision.posZ()) * RecoDecay::getMassPDG(kLambda0) < lifetimecut->get("lifetimecutLambda")) {
-            registry.fill(HIST("h3dMassLambda"), collision.centV0M(), v0.pt(), v0.mLambda());
-            registry.fill(HIST("h3dMassAntiLambda"), collision.centV0M(), v0.pt(), v0.mAntiLambda());
-            if (saveDcaHist == 1) {
-              registry.fill(HIST("h3dMassLambdaDca"), v0.dcaV0daughters(), v0.pt(), v0.mLambda());
-              registry.fill(HIST("h3dMassAntiLambdaDca"), v0.dcaV0daughters(), v0.pt(), v0.mAntiLambda());
-            }
+      if (TMath::Abs(v0.yLambda()) < rapidity) {
+        if (v0.distOverTotMom() * RecoDecay::getMassPDG(kLambda0) < lifetimecut->get("lifetimecutLambda")) {
+          registry.fill(HIST("h3dMassLambda"), collision.centV0M(), v0.pt(), v0.mLambda());
+          registry.fill(HIST("h3dMassAntiLambda"), collision.centV0M(), v0.pt(), v0.mAntiLambda());
+          if (saveDcaHist == 1) {
+            registry.fill(HIST("h3dMassLambdaDca"), v0.dcaV0daughters(), v0.pt(), v0.mLambda());
+            registry.fill(HIST("h3dMassAntiLambdaDca"), v0.dcaV0daughters(), v0.pt(), v0.mAntiLambda());
           }
         }
-        if (TMath::Abs(v0.yK0Short()) < rapidity) {
-          if (v0.distovertotmom(collision.posX(), collision.posY(), collision.posZ()) * RecoDecay::getMassPDG(kK0Short) < lifetimecut->get("lifetimecutK0S")) {
-            registry.fill(HIST("h3dMassK0Short"), collision.centV0M(), v0.pt(), v0.mK0Short());
-            if (saveDcaHist == 1) {
-              registry.fill(HIST("h3dMassK0ShortDca"), v0.dcaV0daughters(), v0.pt(), v0.mK0Short());
-            }
+      }
+      if (TMath::Abs(v0.yK0Short()) < rapidity) {
+        if (v0.distOverTotMom() * RecoDecay::getMassPDG(kK0Short) < lifetimecut->get("lifetimecutK0S")) {
+          registry.fill(HIST("h3dMassK0Short"), collision.centV0M(), v0.pt(), v0.mK0Short());
+          if (saveDcaHist == 1) {
+            registry.fill(HIST("h3dMassK0ShortDca"), v0.dcaV0daughters(), v0.pt(), v0.mK0Short());
           }
         }
       }
@@ -214,6 +320,7 @@ struct lambdakzeroanalysis {
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
 {
   return WorkflowSpec{
+    adaptAnalysisTask<lambdakzerotopology>(cfgc, TaskName{"lf-lambdakzerotopology"}),
     adaptAnalysisTask<lambdakzeroanalysis>(cfgc, TaskName{"lf-lambdakzeroanalysis"}),
     adaptAnalysisTask<lambdakzeroQA>(cfgc, TaskName{"lf-lambdakzeroQA"})};
 }
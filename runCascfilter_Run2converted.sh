@@ -2,6 +2,7 @@
 
 o2-analysis-weak-decay-indices -b  --shm-segment-size 6000000000  --configuration json://${PWD}/triggerjson_Run3conv.json \
 | o2-analysis-event-selection -b --configuration json://${PWD}/triggerjson_Run3conv.json \
+| o2-analysis-strangeness-event-selection -b --configuration json://${PWD}/triggerjson_Run3conv.json \
 | o2-analysis-timestamp -b --shm-segment-size 6000000000 --configuration json://${PWD}/triggerjson_Run3conv.json \
 | o2-analysis-multiplicity-table -b --configuration json://${PWD}/triggerjson_Run3conv.json \
 | o2-analysis-trackextension -b --configuration json://${PWD}/triggerjson_Run3conv.json \
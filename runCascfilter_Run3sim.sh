@@ -2,6 +2,7 @@
 
 o2-analysis-timestamp -b --configuration json://${PWD}/triggerjson_Run3sim.json \
 | o2-analysis-event-selection -b --configuration json://${PWD}/triggerjson_Run3sim.json \
+| o2-analysis-strangeness-event-selection -b --configuration json://${PWD}/triggerjson_Run3sim.json \
 | o2-analysis-multiplicity-table -b --configuration json://${PWD}/triggerjson_Run3sim.json \
 | o2-analysis-trackextension -b --configuration json://${PWD}/triggerjson_Run3sim.json \
 | o2-analysis-trackselection -b --configuration json://${PWD}/triggerjson_Run3sim.json \
@@ -0,0 +1,50 @@
+#! /usr/bin/env bash
+#
+# Time saved by the event selection in the collision Filter (StrangenessEvSels) with respect to
+# the selection in process. Runs the strangeness filters and the V0 analysis twice on the same
+# input: with the default minEvSelLevel (rejected collisions are never grouped with the candidate
+# tables) and with minEvSelLevel 0 (every collision grouped, rejected in process). The outputs
+# must be identical, only the wall time changes; the gain grows with the rejected fraction.
+#
+# usage: ./runEvSelFilterBenchmark.sh [configuration=triggerjson_Run3sim.json]
+
+set -u
+
+CONFIG=json://${PWD}/${1:-triggerjson_Run3sim.json}
+
+run_chain() # <minEvSelLevel option> <output directory>
+{
+  mkdir -p $2
+  o2-analysis-timestamp -b --configuration ${CONFIG} \
+  | o2-analysis-event-selection -b --configuration ${CONFIG} \
+  | o2-analysis-strangeness-event-selection -b --configuration ${CONFIG} \
+  | o2-analysis-multiplicity-table -b --configuration ${CONFIG} \
+  | o2-analysis-trackextension -b --configuration ${CONFIG} \
+  | o2-analysis-trackselection -b --configuration ${CONFIG} \
+  | o2-analysis-centrality-table -b --configuration ${CONFIG} \
+  | o2-analysis-pid-tpc -b --configuration ${CONFIG} \
+  | o2-analysis-pid-tof -b --configuration ${CONFIG} \
+  | o2-analysis-weak-decay-indices -b --configuration ${CONFIG} \
+  | o2-analysis-lf-lambdakzerobuilder -b --configuration ${CONFIG} \
+  | o2-analysis-lf-lambdakzeroanalysis -b --configuration ${CONFIG} $1 \
+  | o2-analysis-lf-cascadebuilder -b --configuration ${CONFIG} \
+  | o2-analysis-strangeness-filter-K0s -b --configuration ${CONFIG} $1 \
+  | o2-analysis-lf-strangeness-filter -b --configuration ${CONFIG} $1 > $2/run.log 2>&1 \
+  && mv AnalysisResults.root $2/
+}
+
+START=$(date +%s.%N)
+run_chain "" evSelFilter || { echo "run with the Filter failed, see evSelFilter/run.log"; exit 1; }
+FILTERTIME=$(echo "$(date +%s.%N) - ${START}" | bc)
+
+START=$(date +%s.%N)
+run_chain "--minEvSelLevel 0" evSelInProcess || { echo "run with the selection in process failed, see evSelInProcess/run.log"; exit 1; }
+PROCESSTIME=$(echo "$(date +%s.%N) - ${START}" | bc)
+
+root -l -b -q -e '
+  TFile f("evSelFilter/AnalysisResults.root");
+  TH1* h = (TH1*)f.Get("lf-strangeness-event-selection/hEvSelLevel");
+  if (h && h->GetEntries() > 0) printf("Collisions: %.0f, rejected (no kINT7): %.1f%%\n", h->GetEntries(), 100. * h->GetBinContent(1) / h->GetEntries());'
+echo "Selection in the collision Filter : ${FILTERTIME} s"
+echo "Selection in process              : ${PROCESSTIME} s"
+echo "Time saved                        : $(echo "${PROCESSTIME} - ${FILTERTIME}" | bc) s"
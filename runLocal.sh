@@ -0,0 +1,74 @@
+#! /usr/bin/env bash
+#
+# Local multi-process replacement of the grid test mode of runGrid.C / run_kzeroshort.C.
+# Forks N root processes on disjoint shards of a file list (runLocal.C) and merges their
+# outputs with a parallel pairwise hadd tree: log2(N) rounds, each round in parallel.
+#
+# usage: ./runLocal.sh <file list> [workers=nproc] [analysis=QAMultistrangev2] [isMC=0] [output=AnalysisResults.root]
+#   file list: one ESD/AOD file per line (local path or root:// URL), '#' comments allowed
+#   analysis:  QAMultistrangev2 (ESD), Kzeroshort (AOD) or StrAODCfrO2 (AOD)
+
+set -u
+
+FILELIST=${1:?usage: $0 <file list> [workers] [analysis] [isMC] [output]}
+NWORKERS=${2:-$(nproc)}
+ANALYSIS=${3:-QAMultistrangev2}
+ISMC=${4:-0}
+OUTPUT=${5:-AnalysisResults.root}
+WORKDIR=localRun_${ANALYSIS}
+
+# outputs of a previous run must not be merged with this one
+rm -rf ${WORKDIR}
+mkdir -p ${WORKDIR}
+FILELIST=$(readlink -f ${FILELIST})
+
+# build the task library once, before forking
+root -l -b -q "runLocal.C(\"\",0,1,\"${ANALYSIS}\",${ISMC},\"\",kTRUE)" > ${WORKDIR}/compile.log 2>&1 \
+  || { echo "compilation failed, see ${WORKDIR}/compile.log"; exit 1; }
+
+# workers: one process per shard, each in its own directory (output, log, EventStat_temp.root)
+START=$(date +%s.%N)
+PIDS=()
+for ((i = 0; i < NWORKERS; i++)); do
+  mkdir -p ${WORKDIR}/worker_${i}
+  root -l -b -q "runLocal.C(\"${FILELIST}\",${i},${NWORKERS},\"${ANALYSIS}\",${ISMC},\"AnalysisResults.root\",kFALSE,\"${WORKDIR}/worker_${i}\")" \
+    > ${WORKDIR}/worker_${i}/worker.log 2>&1 &
+  PIDS+=($!)
+done
+FAILED=0
+for ((i = 0; i < NWORKERS; i++)); do
+  wait ${PIDS[$i]} || { echo "worker ${i} failed, see ${WORKDIR}/worker_${i}/worker.log"; FAILED=1; }
+done
+WORKERTIME=$(echo "$(date +%s.%N) - ${START}" | bc)
+NFILES=$(grep -v -e '^#' -e '^$' ${FILELIST} | wc -l)
+echo "workers done in ${WORKERTIME} s, $(echo "${NFILES} * 3600 / ${WORKERTIME}" | bc) files/hour"
+[ ${FAILED} -eq 0 ] || exit 1
+
+# parallel tree reduction: every round merges the files pairwise, all pairs at once;
+# only the outputs of the workers of this run (a worker with an empty shard writes none)
+FILES=()
+for ((i = 0; i < NWORKERS; i++)); do
+  [ -f ${WORKDIR}/worker_${i}/AnalysisResults.root ] && FILES+=(${WORKDIR}/worker_${i}/AnalysisResults.root)
+done
+[ ${#FILES[@]} -gt 0 ] || { echo "no worker output"; exit 1; }
+ROUND=0
+while [ ${#FILES[@]} -gt 1 ]; do
+  NEXT=()
+  PIDS=()
+  for ((i = 0; i + 1 < ${#FILES[@]}; i += 2)); do
+    MERGED=${WORKDIR}/merge_${ROUND}_$((i / 2)).root
+    hadd -f -k ${MERGED} ${FILES[$i]} ${FILES[$((i + 1))]} > ${MERGED%.root}.log 2>&1 &
+    PIDS+=($!)
+    NEXT+=(${MERGED})
+  done
+  # odd one out goes to the next round as it is
+  [ $(( ${#FILES[@]} % 2 )) -eq 1 ] && NEXT+=(${FILES[$(( ${#FILES[@]} - 1 ))]})
+  for PID in ${PIDS[@]}; do
+    wait ${PID} || { echo "merging failed in round ${ROUND}, see ${WORKDIR}/merge_${ROUND}_*.log"; exit 1; }
+  done
+  FILES=(${NEXT[@]})
+  ROUND=$((ROUND + 1))
+done
+
+cp ${FILES[0]} ${OUTPUT}
+echo "merged output in ${OUTPUT} after ${ROUND} rounds, $(echo "$(date +%s.%N) - ${START}" | bc) s in total"
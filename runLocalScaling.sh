@@ -0,0 +1,25 @@
+#! /usr/bin/env bash
+#
+# Scaling of runLocal.sh with the number of workers: runs the same file list with 1, 2, 4, ...
+# up to N workers and reports the worker-phase throughput (files/hour) and the parallel
+# efficiency, throughput(n) / (n * throughput(1)). Near-linear scaling is an efficiency close
+# to 1; it drops when the input reading saturates the disk or the network.
+#
+# usage: ./runLocalScaling.sh <file list> [max workers=nproc] [analysis=QAMultistrangev2] [isMC=0]
+
+set -u
+
+FILELIST=${1:?usage: $0 <file list> [max workers] [analysis] [isMC]}
+MAXWORKERS=${2:-$(nproc)}
+ANALYSIS=${3:-QAMultistrangev2}
+ISMC=${4:-0}
+
+printf "%8s %14s %12s\n" workers files/hour efficiency
+SINGLE=""
+for ((n = 1; n <= MAXWORKERS; n *= 2)); do
+  RATE=$(./runLocal.sh ${FILELIST} ${n} ${ANALYSIS} ${ISMC} scaling_${n}.root | sed -n 's/.*s, \([0-9.]*\) files\/hour.*/\1/p')
+  [ -n "${RATE}" ] || { echo "run with ${n} workers failed, see localRun_${ANALYSIS}"; exit 1; }
+  SINGLE=${SINGLE:-${RATE}}
+  printf "%8d %14.0f %12.2f\n" ${n} ${RATE} $(echo "${RATE} / (${n} * ${SINGLE})" | bc -l)
+  rm -f scaling_${n}.root
+done
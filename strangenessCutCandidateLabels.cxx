@@ -0,0 +1,88 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+/// \brief MC truth of the Xi candidates written by the strangeness filter for the cut optimiser
+//  usage (MC):
+/*
+  ... | o2-analysis-lf-strangeness-filter -b --cutCandidateOutput 1 | \
+  o2-analysis-strangeness-cut-candidate-labels -b --aod-writer-keep AOD/StrgCutCand/0,AOD/StrgCutCandLbl/0,AOD/StrgFltSummary/0
+*/
+///  One StrangenessCutCandLabels row per StrangenessCutCands row: the candidate is signal when
+///  the bachelor comes from a generated Xi and the V0 daughters from a Lambda, daughter of the
+///  same Xi. The signal candidates of MC and the (unlabelled) candidates of data are the
+///  input of o2-analysis-strangeness-cut-optimiser.
+///
+/// \author Francesca Ercolessi (francesca.ercolessi@cern.ch)
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/AnalysisTask.h"
+#include "Framework/AnalysisDataModel.h"
+#include "Common/DataModel/StrangenessTables.h"
+
+#include <TH1F.h>
+#include <cstdlib>
+
+#include "../filterTables.h"
+
+using namespace o2;
+using namespace o2::framework;
+
+struct strangenessCutCandidateLabels {
+
+  Produces<aod::StrangenessCutCandLabels> labels;
+
+  OutputObj<TH1F> hCandidates{TH1F("hCandidates", "Cut-optimiser candidates; ; Candidates", 2, 0., 2.)};
+
+  using LabeledTracks = soa::Join<aod::Tracks, aod::McTrackLabels>;
+
+  void init(InitContext const&)
+  {
+    hCandidates->GetXaxis()->SetBinLabel(1, "Background");
+    hCandidates->GetXaxis()->SetBinLabel(2, "Signal");
+  }
+
+  /// index of the generated mother of a track with the given |PDG code|, -1 otherwise
+  template <typename T>
+  int motherOf(T const& track, int pdg)
+  {
+    if (track.mcParticleId() < 0) {
+      return -1;
+    }
+    auto particle = track.template mcParticle_as<aod::McParticles>();
+    if (particle.mother0Id() < 0) {
+      return -1;
+    }
+    auto mother = particle.template mother0_as<aod::McParticles>();
+    return std::abs(mother.pdgCode()) == pdg ? mother.globalIndex() : -1;
+  }
+
+  void process(aod::StrangenessCutCands const& candidates, aod::CascDataExt const&, aod::V0Datas const&, LabeledTracks const&, aod::McParticles const& particles)
+  {
+    for (auto& candidate : candidates) {
+      auto casc = candidate.cascData_as<aod::CascDataExt>();
+      auto v0 = casc.v0_as<aod::V0Datas>();
+      int xi = motherOf(casc.bachelor_as<LabeledTracks>(), 3312);
+      int lambda = motherOf(v0.posTrack_as<LabeledTracks>(), 3122);
+      bool signal = xi >= 0 && lambda >= 0 && lambda == motherOf(v0.negTrack_as<LabeledTracks>(), 3122);
+      if (signal) {
+        auto lambdaParticle = particles.iteratorAt(lambda);
+        signal = lambdaParticle.mother0Id() == xi;
+      }
+      hCandidates->Fill(signal + 0.5);
+      labels(signal);
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{
+    adaptAnalysisTask<strangenessCutCandidateLabels>(cfgc, TaskName{"lf-strangeness-cut-candidate-labels"})};
+}
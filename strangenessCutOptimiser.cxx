@@ -0,0 +1,322 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+/// \brief Rate vs efficiency optimisation of the Xi cuts of the strangeness filter
+//  usage:
+/*
+  o2-analysis-strangeness-cut-optimiser -s @mcList.txt -b @dataList.txt -r 1e-3 -j triggerjson_Run3sim.json
+*/
+///  Scans casccospa, dcav0topv, ximasswindow and properlifetimefactor on the candidates cached by
+///  the filter (--cutCandidateOutput, tables StrgCutCand and StrgFltSummary in the AO2D):
+///  signal from MC (StrgCutCandLbl of o2-analysis-strangeness-cut-candidate-labels), background
+///  from data. The rate is the fraction of the inspected collisions (StrgFltSummary) with at
+///  least -k passing candidates: 2 for the double-Xi trigger. With -k 1 the rate is the one of
+///  the events with at least one Xi, an upper bound of the hadron-Xi rate: the high-pT track
+///  of the hadron-Xi trigger is not cached and its requirement is ignored.
+///  The Pareto front is written to a text file; with -r, its point of highest efficiency below
+///  the target rate is written into the lf-strangeness-filter block of the -j configuration.
+///  Options:
+///   -s <file|@list> signal (MC) AO2Ds, repeatable
+///   -b <file|@list> background (data) AO2Ds, repeatable
+///   -n <steps>      grid points per variable (default 10)
+///   -e <eff>        tightest cut of each variable, as its signal efficiency alone (default 0.5)
+///   -k <n>          passing candidates per triggered collision (default 1: >= 1 Xi, not the
+///                   hadron-Xi, whose high-pT track requirement is ignored)
+///   -t <threads>    (default: hardware threads)
+///   -r <rate>       target rate, fraction of the inspected collisions
+///   -j <json>       configuration updated with the chosen point (with -r)
+///   -o <file>       Pareto front (default cutOptimiserPareto.txt)
+///
+/// \author Francesca Ercolessi (francesca.ercolessi@cern.ch)
+
+#include <TFile.h>
+#include <TKey.h>
+#include <TTree.h>
+
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../cutOptimiser.h"
+
+namespace
+{
+
+/// same order as the values read from StrgCutCand
+const std::vector<o2::filtering::CutVariable> kVariables{
+  {"casccospa", true, false},
+  {"dcav0topv", true, false},
+  {"ximasswindow", false, false},
+  {"properlifetimefactor", false, true}};
+const char* kColumns[] = {"fCascCosPA", "fDCAV0ToPV", "fDMassXi", "fLifetimeXi"};
+
+/// file names of a file or of an @list (one file per line, as aod-file)
+void expand(const std::string& name, std::vector<std::string>& files)
+{
+  if (name.empty() || name[0] != '@') {
+    files.push_back(name);
+    return;
+  }
+  std::ifstream list(name.substr(1));
+  std::string line;
+  while (std::getline(list, line)) {
+    if (!line.empty() && line[0] != '#') {
+      files.push_back(line);
+    }
+  }
+}
+
+/// adds the candidates of the DF_ directories of a file; returns false on missing tables
+bool load(const std::string& fileName, bool signal, o2::filtering::CutOptimiser& optimiser, double& nInspected, uint64_t& dataFrame)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str()));
+  if (!file || file->IsZombie()) {
+    fprintf(stderr, "strangeness-cut-optimiser: cannot open %s\n", fileName.c_str());
+    return false;
+  }
+  for (auto key : *file->GetListOfKeys()) {
+    std::string name = static_cast<TKey*>(key)->GetName();
+    TDirectory* dir = name.compare(0, 3, "DF_") == 0 ? file->GetDirectory(name.c_str()) : nullptr;
+    if (!dir) {
+      continue;
+    }
+    dataFrame++;
+    TTree* candidates = dir->Get<TTree>("O2strgcutcand");
+    TTree* labels = signal ? dir->Get<TTree>("O2strgcutcandlbl") : nullptr;
+    if (!candidates || (signal && (!labels || labels->GetEntries() != candidates->GetEntries()))) {
+      fprintf(stderr, "strangeness-cut-optimiser: %s/%s without %s\n", fileName.c_str(), dir->GetName(), candidates ? "O2strgcutcandlbl" : "O2strgcutcand");
+      return false;
+    }
+    if (!signal) {
+      TTree* summary = dir->Get<TTree>("O2strgfltsummary");
+      ULong64_t inspected = 0;
+      if (summary) {
+        summary->SetBranchAddress("fNInspected", &inspected);
+        for (Long64_t i = 0; i < summary->GetEntries(); i++) {
+          summary->GetEntry(i);
+          nInspected += inspected;
+        }
+      }
+    }
+    Int_t collision = 0;
+    Float_t values[4];
+    Bool_t isSignal = kFALSE;
+    candidates->SetBranchAddress("fIndexCollisions", &collision);
+    for (int v = 0; v < 4; v++) {
+      candidates->SetBranchAddress(kColumns[v], &values[v]);
+    }
+    if (labels) {
+      labels->SetBranchAddress("fIsSignal", &isSignal);
+    }
+    for (Long64_t i = 0; i < candidates->GetEntries(); i++) {
+      candidates->GetEntry(i);
+      if (labels) {
+        labels->GetEntry(i);
+        if (!isSignal) {
+          continue;
+        }
+      }
+      optimiser.addCandidate(signal, (dataFrame << 32) | uint32_t(collision), values);
+    }
+  }
+  return true;
+}
+
+std::string format(const o2::filtering::CutVariable& variable, float cut)
+{
+  char value[32];
+  snprintf(value, sizeof(value), variable.integer ? "%.0f" : "%.9g", cut);
+  return value;
+}
+
+/// sets the cuts in the lf-strangeness-filter block of a DPL json configuration, adding the block if needed
+bool writeConfiguration(const std::string& fileName, const o2::filtering::CutOptimiser::Point& point)
+{
+  std::ifstream in(fileName);
+  if (!in) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  std::string json = buffer.str();
+  in.close();
+  size_t task = json.find("\"lf-strangeness-filter\"");
+  if (task == std::string::npos) {
+    size_t end = json.rfind('}');
+    if (end == std::string::npos) {
+      return false;
+    }
+    size_t last = json.find_last_not_of(" \t\r\n", end - 1);
+    json.insert(last + 1, ",\n    \"lf-strangeness-filter\": {\n    }");
+    task = json.find("\"lf-strangeness-filter\"");
+  }
+  size_t open = json.find('{', task), close = json.find('}', open);
+  if (open == std::string::npos || close == std::string::npos) {
+    return false;
+  }
+  std::string block = json.substr(open + 1, close - open - 1);
+  for (size_t v = 0; v < kVariables.size(); v++) {
+    std::string value = format(kVariables[v], point.cuts[v]);
+    std::regex entry("\"" + kVariables[v].name + "\"\\s*:\\s*\"[^\"]*\"");
+    if (std::regex_search(block, entry)) {
+      block = std::regex_replace(block, entry, "\"" + kVariables[v].name + "\": \"" + value + "\"");
+    } else {
+      size_t last = block.find_last_not_of(" \t\r\n");
+      std::string separator = last == std::string::npos ? "" : ",";
+      block.insert(last == std::string::npos ? 0 : last + 1, separator + "\n        \"" + kVariables[v].name + "\": \"" + value + "\"");
+    }
+  }
+  block.erase(block.find_last_not_of(" \t\r\n") + 1);
+  block += "\n    ";
+  json.replace(open + 1, close - open - 1, block);
+  std::ofstream out(fileName);
+  out << json;
+  return bool(out);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const char* usage = "usage: %s -s signal.root|@list -b background.root|@list [-n steps] [-e min efficiency] [-k candidates (1: >= 1 Xi, not hadron-Xi)] [-t threads] [-r rate -j triggerjson.json] [-o pareto.txt]\n";
+  std::vector<std::string> signalFiles, backgroundFiles;
+  int nSteps = 10, minCandidates = 1;
+  int nThreads = std::max(1u, std::thread::hardware_concurrency());
+  double minEfficiency = 0.5, targetRate = -1.;
+  std::string jsonName, paretoName = "cutOptimiserPareto.txt";
+  int opt;
+  while ((opt = getopt(argc, argv, "s:b:n:e:k:t:r:j:o:")) != -1) {
+    switch (opt) {
+      case 's':
+        expand(optarg, signalFiles);
+        break;
+      case 'b':
+        expand(optarg, backgroundFiles);
+        break;
+      case 'n':
+        nSteps = std::max(1, atoi(optarg));
+        break;
+      case 'e':
+        minEfficiency = atof(optarg);
+        break;
+      case 'k':
+        minCandidates = atoi(optarg);
+        break;
+      case 't':
+        nThreads = std::max(1, atoi(optarg));
+        break;
+      case 'r':
+        targetRate = atof(optarg);
+        break;
+      case 'j':
+        jsonName = optarg;
+        break;
+      case 'o':
+        paretoName = optarg;
+        break;
+      default:
+        fprintf(stderr, usage, argv[0]);
+        return 1;
+    }
+  }
+  if (signalFiles.empty() || backgroundFiles.empty()) {
+    fprintf(stderr, usage, argv[0]);
+    return 1;
+  }
+
+  o2::filtering::CutOptimiser optimiser(kVariables);
+  optimiser.setMinCandidates(minCandidates);
+  double nInspected = 0.;
+  uint64_t dataFrame = 0;
+  for (auto& name : signalFiles) {
+    if (!load(name, true, optimiser, nInspected, dataFrame)) {
+      return 1;
+    }
+  }
+  for (auto& name : backgroundFiles) {
+    if (!load(name, false, optimiser, nInspected, dataFrame)) {
+      return 1;
+    }
+  }
+  if (nInspected > 0.) {
+    optimiser.setInspectedEvents(nInspected);
+  } else {
+    fprintf(stderr, "strangeness-cut-optimiser: no StrgFltSummary in the background, rate relative to the collisions with candidates\n");
+  }
+  printf("Signal candidates: %zu, background candidates: %zu in %zu collisions, inspected collisions: %.0f\n",
+         optimiser.nSignal(), optimiser.nBackground(), optimiser.nBackgroundEvents(), optimiser.inspected());
+
+  auto start = std::chrono::steady_clock::now();
+  if (!optimiser.buildGrid(nSteps, minEfficiency)) {
+    fprintf(stderr, "strangeness-cut-optimiser: no signal or no background candidates\n");
+    return 1;
+  }
+  auto gridEnd = std::chrono::steady_clock::now();
+  auto points = optimiser.scan(nThreads);
+  double scanSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - gridEnd).count();
+  printf("Grid in %.2f s, %zu combinations in %.2f s on %d threads: %.0f combinations/s\n",
+         std::chrono::duration<double>(gridEnd - start).count(), points.size(), scanSeconds, nThreads, scanSeconds > 0. ? points.size() / scanSeconds : 0.);
+
+  auto front = o2::filtering::CutOptimiser::paretoFront(points);
+  FILE* out = fopen(paretoName.c_str(), "w");
+  if (!out) {
+    fprintf(stderr, "strangeness-cut-optimiser: cannot write %s\n", paretoName.c_str());
+    return 1;
+  }
+  fprintf(out, "# rate efficiency");
+  for (auto& variable : kVariables) {
+    fprintf(out, " %s", variable.name.c_str());
+  }
+  fprintf(out, "\n");
+  for (auto& point : front) {
+    fprintf(out, "%.6g %.6g", point.rate, point.efficiency);
+    for (size_t v = 0; v < kVariables.size(); v++) {
+      fprintf(out, " %s", format(kVariables[v], point.cuts[v]).c_str());
+    }
+    fprintf(out, "\n");
+  }
+  fclose(out);
+  printf("Pareto front: %zu points in %s\n", front.size(), paretoName.c_str());
+
+  if (targetRate < 0.) {
+    return 0;
+  }
+  const o2::filtering::CutOptimiser::Point* chosen = nullptr;
+  for (auto& point : front) {
+    if (point.rate <= targetRate) {
+      chosen = &point; // increasing rate and efficiency along the front
+    }
+  }
+  if (!chosen) {
+    fprintf(stderr, "strangeness-cut-optimiser: no point below the rate %g, lowest %g\n", targetRate, front.empty() ? 0. : front.front().rate);
+    return 1;
+  }
+  printf("Chosen point: rate %.6g, efficiency %.6g:", chosen->rate, chosen->efficiency);
+  for (size_t v = 0; v < kVariables.size(); v++) {
+    printf(" %s=%s", kVariables[v].name.c_str(), format(kVariables[v], chosen->cuts[v]).c_str());
+  }
+  printf("\n");
+  if (!jsonName.empty()) {
+    if (!writeConfiguration(jsonName, *chosen)) {
+      fprintf(stderr, "strangeness-cut-optimiser: cannot update %s\n", jsonName.c_str());
+      return 1;
+    }
+    printf("Cuts written to the lf-strangeness-filter block of %s\n", jsonName.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,65 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+/// \brief Event selection of the strangeness filters and analyses, as a column
+//  usage:
+/*
+  ... | o2-analysis-event-selection -b | \
+  o2-analysis-strangeness-event-selection -b | \
+  o2-analysis-strangeness-filter -b
+*/
+///  The trigger alias is an array column and cannot be used in a Filter expression: this task
+///  writes one StrangenessEvSels row per collision with the selection level (kINT7, kINT7 and
+///  sel7), so that the consumers select the collisions with a Filter on evSelLevel and the
+///  rejected ones are never grouped with the candidate tables.
+///
+/// \author Francesca Ercolessi (francesca.ercolessi@cern.ch)
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/AnalysisTask.h"
+#include "Framework/AnalysisDataModel.h"
+#include "Common/DataModel/EventSelection.h"
+
+#include <TH1F.h>
+
+#include "../filterTables.h"
+
+using namespace o2;
+using namespace o2::framework;
+
+struct strangenessEventSelection {
+
+  Produces<aod::StrangenessEvSels> evSels;
+
+  OutputObj<TH1F> hEvSelLevel{TH1F("hEvSelLevel", "Collisions per selection level; ; Collisions", 3, 0., 3.)};
+
+  void init(InitContext const&)
+  {
+    hEvSelLevel->GetXaxis()->SetBinLabel(aod::kEvSelNone + 1, "Rejected");
+    hEvSelLevel->GetXaxis()->SetBinLabel(aod::kEvSelINT7 + 1, "kINT7, !sel7");
+    hEvSelLevel->GetXaxis()->SetBinLabel(aod::kEvSelINT7Sel7 + 1, "kINT7 && sel7");
+  }
+
+  void process(soa::Join<aod::Collisions, aod::EvSels>::iterator const& collision)
+  {
+    int level = aod::kEvSelNone;
+    if (collision.alias()[kINT7]) {
+      level = collision.sel7() ? aod::kEvSelINT7Sel7 : aod::kEvSelINT7;
+    }
+    hEvSelLevel->Fill(level + 0.5);
+    evSels(level);
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{
+    adaptAnalysisTask<strangenessEventSelection>(cfgc, TaskName{"lf-strangeness-event-selection"})};
+}
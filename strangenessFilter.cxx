@@ -13,6 +13,7 @@
 /*  
   o2-analysis-timestamp -b --aod-file AO2D.root   | \
   o2-analysis-event-selection -b | \
+  o2-analysis-strangeness-event-selection -b | \
   o2-analysis-trackselection -b | \
   o2-analysis-trackextension -b | \
   o2-analysis-multiplicity-table -b | \
@@ -24,7 +25,16 @@
   o2-analysis-cascadebuilder  --d_bz 5 -b | \
   o2-analysis-strangeness-filter -b   
 */
-///
+///  With --omegaML the Omegas are selected by a gradient-boosted tree model (omegaMLModel,
+///  XGBoost text dump) evaluated on all the candidates of the collision in one batch. The
+///  Omega cut chain is timed on the same features: the inference must not cost more, and both
+///  rates are logged at the end of the stream, with a warning when the model is over budget.
+///  See BenchmarkCascadeBDT.C for the inference throughput against a cut chain.
+///  With --rateControl the trigger bits are downscaled to targetRates, measured on the global BC
+///  over a sliding window (triggerRateController.h); the QA histograms count the triggers before
+///  the downscale and every change of a factor is a StrangenessRateControls row. Each pipelined
+///  instance only sees its share of the time frames: set rateControlInstances to the --pipeline
+///  value, or run the filter un-pipelined when the rates must be exact.
 ///
 /// \author Chiara De Martin (chiara.de.martin@cern.ch)
 /// \author Francesca Ercolessi (francesca.ercolessi@cern.ch)
@@ -54,9 +64,17 @@
 #include <cmath>
 #include <array>
 #include <cstdlib>
+#include <chrono>
 #include "Framework/ASoAHelpers.h"
 
+#include "Framework/CallbackService.h"
+#include "Framework/EndOfStreamContext.h"
+
 #include "../filterTables.h"
+#include "../triggerBitmapIndex.h"
+#include "../AliStrangenessKernels.h"
+#include "../gradientBoostedTrees.h"
+#include "../triggerRateController.h"
 
 using namespace o2;
 using namespace o2::framework;
@@ -67,6 +85,10 @@ struct strangenessFilter {
 
   //Recall the output table
   Produces<aod::StrangenessFilters> strgtable;
+  Produces<aod::StrangenessSparseFilters> strgsparsetable;
+  Produces<aod::StrangenessFilterSummaries> strgsummary;
+  Produces<aod::StrangenessCutCands> strgcutcands;
+  Produces<aod::StrangenessRateControls> strgratecontrols;
 
   //Define a histograms and registries
   HistogramRegistry QAHistos{"QAHistos", {}, OutputObjHandlingPolicy::AnalysisObject, true, true};
@@ -74,7 +96,28 @@ struct strangenessFilter {
   OutputObj<TH1F> hProcessedEvents{TH1F("hProcessedEvents", "Strangeness - event filtered; Event counter; Number of events", 7, 0., 7.)};
 
   //Selection criteria for cascades
+  Configurable<bool> denseOutput{"denseOutput", true, "Write one StrangenessFilters row per collision"};
+  Configurable<bool> sparseOutput{"sparseOutput", true, "Write StrangenessSparseFilters rows for the triggered collisions only"};
+  Configurable<bool> cutCandidateOutput{"cutCandidateOutput", false, "Write the preselected Xi candidates (StrangenessCutCands) for strangeness-cut-optimiser"};
+  Configurable<std::string> bitmapIndexFile{"bitmapIndexFile", "strangenessTriggerIndex.bin", "Sidecar trigger index, written at the end of the stream (processBitmapIndex)"};
+
+  //Trigger index: bitmaps of the triggered collisions and data frames with hits, filled per data frame
+  o2::filtering::TriggerBitmapIndex bitmapIndex{{"Omega", "hadronXi", "DoubleXi", "TripleXi", "QuadrupleXi", "SingleXi"}};
+  std::vector<std::pair<uint32_t, uint32_t>> bitmapIndexHits; // (collision row, decisions) of the current data frame
+
+  //Trigger-rate control: per-bit downscales adjusted to target rates, changes logged in StrangenessRateControls
+  Configurable<bool> rateControl{"rateControl", false, "Downscale the triggers to targetRates"};
+  Configurable<std::vector<float>> targetRates{"targetRates", {0.f, 0.f, 0.f, 0.f, 0.f, 0.f}, "Target accept rate (Hz) of Omega, hadronXi, DoubleXi, TripleXi, QuadrupleXi, SingleXi; 0: not downscaled"};
+  Configurable<float> rateWindow{"rateWindow", 10.f, "Sliding window of the rate measurement (s)"};
+  Configurable<int> rateWindowSlots{"rateWindowSlots", 10, "Slots of the window, the downscales are updated at every slot"};
+  Configurable<float> maxDownscale{"maxDownscale", 1000.f, "Max downscale factor"};
+  Configurable<float> rateControlGain{"rateControlGain", 0.5f, "Fraction of the (logarithmic) correction applied per slot"};
+  Configurable<float> rateControlTolerance{"rateControlTolerance", 0.02f, "Relative deviation of the downscale below which it is not changed"};
+  Configurable<int> rateControlInstances{"rateControlInstances", 1, "Pipelined instances of the task (--pipeline), the measured rates are scaled by it"};
+  o2::filtering::TriggerRateController rateController;
+
   Configurable<float> cutzvertex{"cutzvertex", 10.0f, "Accepted z-vertex range"};
+  Configurable<int> minEvSelLevel{"minEvSelLevel", aod::kEvSelINT7Sel7, "Min StrangenessEvSelLevel in the collision Filter (0: selection in process, for timing comparisons)"};
   Configurable<float> v0cospa{"v0cospa", 0.97, "V0 CosPA"}; //is it with respect to Xi decay vertex?
   Configurable<float> casccospa{"casccospa", 0.995, "V0 CosPA"};
   Configurable<float> dcav0dau{"dcav0dau", 1.5, "DCA V0 Daughters"};       //is it in sigmas?
@@ -102,12 +145,91 @@ struct strangenessFilter {
   Configurable<float> nsigmatpc{"nsigmatpc", 6, "N Sigmas TPC"};
   Configurable<float> nsigmatof{"nsigmatof", 5, "N Sigmas TOF (OOB condition)"};
 
+  //ML selection of the Omegas: gradient-boosted trees on the cascade features, instead of the cut chain
+  Configurable<bool> omegaML{"omegaML", false, "Select the Omegas with the BDT (omegaMLModel) instead of the cuts"};
+  Configurable<std::string> omegaMLModel{"omegaMLModel", "omegaBDT.txt", "XGBoost text dump of the Omega BDT, features named as in omegaBDT"};
+  Configurable<float> omegaMLThreshold{"omegaMLThreshold", 0.9, "Min BDT response of the Omegas"};
+
+  //Features of the Omega BDT, in the order of OmegaFeature; baryon/meson: V0 daughters by cascade sign
+  enum OmegaFeature { kCascCosPA = 0,
+                      kV0CosPA,
+                      kDCAV0ToPV,
+                      kDCABachToPV,
+                      kDCABaryonToPV,
+                      kDCAMesonToPV,
+                      kDCAV0Dau,
+                      kDCACascDau,
+                      kV0Radius,
+                      kCascRadius,
+                      kMassLambdaDiff,
+                      kMassXiDiff,
+                      kCTauOmega,
+                      kYOmega,
+                      kEta,
+                      kTPCNSigmaBaryon,
+                      kTPCNSigmaMeson,
+                      kTPCNSigmaBach,
+                      kTOFNSigmaBaryon,
+                      kTOFNSigmaMeson,
+                      kTOFNSigmaBach,
+                      kPt,
+                      kNOmegaFeatures };
+  o2::filtering::GradientBoostedTrees omegaBDT{{"casccosPA", "v0cosPA", "dcav0topv", "dcabachtopv", "dcabaryontopv", "dcamesontopv", "dcav0dau", "dcacascdau", "v0radius", "cascradius", "massLambdaDiff", "massXiDiff",
+                                                "ctauOmega", "yOmega", "eta", "tpcNSigmaBaryon", "tpcNSigmaMeson", "tpcNSigmaBachPi", "tofNSigmaBaryon", "tofNSigmaMeson", "tofNSigmaBachPi", "pt"}};
+  std::array<std::vector<float>, kNOmegaFeatures> omegaFeatures; // Omega candidates of the collision, one vector per feature
+  std::vector<float> omegaMasses, omegaPts, omegaMargins;
+  double cascLoopSeconds = 0., omegaCutSeconds = 0., omegaMLSeconds = 0.; // cascade loop (cuts, features), Omega cuts and BDT on the features
+  long cascLoopCandidates = 0, omegaMLCandidates = 0, omegaCutSelected = 0, omegaMLSelected = 0;
+
   //Selections criteria for tracks
   Configurable<float> hEta{"hEta", 0.8f, "Eta range for trigger particles"};
   Configurable<float> hMinPt{"hMinPt", 1.0f, "Min pt for trigger particles"};
 
-  void init(o2::framework::InitContext&)
+  //Omega cut chain on the features of candidate i, in the order of the cascade loop; the daughter eta cuts have no feature
+  bool passesOmegaCuts(int i, float ctauCut)
   {
+    auto x = [&](OmegaFeature f) { return omegaFeatures[f][i]; };
+    return x(kDCAMesonToPV) >= dcamesontopv && x(kDCABaryonToPV) >= dcabaryontopv &&
+           TMath::Abs(x(kTPCNSigmaMeson)) <= nsigmatpc && TMath::Abs(x(kTPCNSigmaBaryon)) <= nsigmatpc &&
+           (TMath::Abs(x(kTOFNSigmaMeson)) <= nsigmatof || TMath::Abs(x(kTOFNSigmaBaryon)) <= nsigmatof || TMath::Abs(x(kTOFNSigmaBach)) <= nsigmatof) &&
+           TMath::Abs(x(kTPCNSigmaBach)) <= nsigmatpc && x(kDCABachToPV) >= dcabachtopv &&
+           x(kV0Radius) <= v0radiusupperlimit && x(kV0Radius) >= v0radius &&
+           x(kCascRadius) <= cascradiusupperlimit && x(kCascRadius) >= cascradius &&
+           x(kV0CosPA) >= v0cospa && x(kDCAV0Dau) <= dcav0dau && x(kDCACascDau) <= dcacascdau &&
+           x(kMassLambdaDiff) <= masslambdalimit && TMath::Abs(x(kEta)) <= eta &&
+           x(kCascCosPA) > casccospa && x(kDCAV0ToPV) > dcav0topv && x(kMassXiDiff) > xirej &&
+           x(kCTauOmega) < ctauCut;
+  }
+
+  void init(o2::framework::InitContext& ic)
+  {
+    if (omegaML) {
+      if (!omegaBDT.read(omegaMLModel.value)) {
+        LOGF(fatal, "Cannot read the Omega BDT from %s", omegaMLModel.value);
+      }
+      LOGF(info, "Omega BDT %s: %d trees, %d nodes", omegaMLModel.value, omegaBDT.nTrees(), omegaBDT.nNodes());
+    }
+    if (rateControl) {
+      rateController.configure(targetRates.value, rateWindow, rateWindowSlots, maxDownscale, rateControlGain, rateControlTolerance, rateControlInstances);
+    }
+    if (doprocessBitmapIndex || omegaML) {
+      ic.services().get<CallbackService>().set(CallbackService::Id::EndOfStream, [this](EndOfStreamContext&) {
+        if (doprocessBitmapIndex && !bitmapIndex.write(bitmapIndexFile.value)) {
+          LOGF(error, "Cannot write the trigger index to %s", bitmapIndexFile.value);
+        }
+        if (omegaML) {
+          double loopRate = cascLoopSeconds > 0. ? cascLoopCandidates / cascLoopSeconds : 0.;
+          double cutRate = omegaCutSeconds > 0. ? omegaMLCandidates / omegaCutSeconds : 0.;
+          double mlRate = omegaMLSeconds > 0. ? omegaMLCandidates / omegaMLSeconds : 0.;
+          LOGF(info, "Cascade loop: %ld cascades in %.3f s, %.3g cascades/s", cascLoopCandidates, cascLoopSeconds, loopRate);
+          LOGF(info, "Omega cuts: %ld candidates in %.3f s, %.3g candidates/s, %ld selected", omegaMLCandidates, omegaCutSeconds, cutRate, omegaCutSelected);
+          LOGF(info, "Omega BDT: %ld candidates in %.3f s, %.3g candidates/s, %ld selected", omegaMLCandidates, omegaMLSeconds, mlRate, omegaMLSelected);
+          if (omegaMLSeconds > omegaCutSeconds) {
+            LOGF(warning, "Omega BDT %.2f times slower than the cuts on the same candidates, over budget: reduce the number or the depth of the trees", omegaCutSeconds > 0. ? omegaMLSeconds / omegaCutSeconds : 0.);
+          }
+        }
+      });
+    }
     std::vector<double> centBinning = {0., 1., 5., 10., 20., 30., 40., 50., 70., 100.};
     AxisSpec centAxis = {centBinning, "V0M (%)"};
     AxisSpec ximassAxis = {100, 1.30f, 1.34f};
@@ -147,22 +269,20 @@ struct strangenessFilter {
   }
 
   //Filters
-  Filter collisionFilter = (nabs(aod::collision::posZ) < cutzvertex);
+  Filter collisionFilter = (nabs(aod::collision::posZ) < cutzvertex) && (aod::filtering::evSelLevel >= minEvSelLevel);
   Filter trackFilter = (nabs(aod::track::eta) < hEta) && (aod::track::pt > hMinPt) && (aod::track::isGlobalTrack == static_cast<uint8_t>(1u));
   Filter preFilterCasc = nabs(aod::cascdata::dcapostopv) > dcapostopv&& nabs(aod::cascdata::dcanegtopv) > dcanegtopv&& aod::cascdata::dcaV0daughters < dcav0dau&& aod::cascdata::dcacascdaughters < dcacascdau;
 
   //Tables
-  using CollisionCandidates = soa::Filtered<soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms>>::iterator;
+  using CollisionCandidates = soa::Filtered<soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms, aod::StrangenessEvSels>>::iterator;
   using TrackCandidates = soa::Filtered<soa::Join<aod::Tracks, aod::TracksExtra, aod::TrackSelection>>;
   using DaughterTracks = soa::Join<aod::FullTracks, aod::TracksExtended, aod::pidTOFPi, aod::pidTPCPi, aod::pidTOFPr, aod::pidTPCPr>;
   using Cascades = soa::Filtered<aod::CascDataExt>;
 
-  void process(CollisionCandidates const& collision, TrackCandidates const& tracks, Cascades const& fullCasc, aod::V0Datas const& V0s, DaughterTracks& dtracks)
+  void process(CollisionCandidates const& collision, TrackCandidates const& tracks, Cascades const& fullCasc, aod::V0Datas const& V0s, DaughterTracks& dtracks, aod::BCs const&)
   {
-    if (!collision.alias()[kINT7]) {
-      return;
-    }
-    if (!collision.sel7()) {
+    // already applied by collisionFilter, unless minEvSelLevel is lowered
+    if (collision.evSelLevel() < aod::kEvSelINT7Sel7) {
       return;
     }
 
@@ -179,14 +299,21 @@ struct strangenessFilter {
     const float ctauomega = 2.461; //from PDG
 
     // variables
-    float xipos = -1.;
-    float xiproperlifetime = -1.;
-    float omegaproperlifetime = -1.;
-    float xiptotmom = -1.;
+    const float primVtx[3] = {collision.posX(), collision.posY(), collision.posZ()};
+    bool xiproperlifetime = false;    // proper lifetime below the Xi cut
+    bool omegaproperlifetime = false; // proper lifetime below the Omega cut
     int xicounter = 0;
     int xicounterYN = 0;
     int omegacounter = 0;
+    if (omegaML) {
+      for (auto& feature : omegaFeatures) {
+        feature.clear();
+      }
+      omegaMasses.clear();
+      omegaPts.clear();
+    }
 
+    auto loopStart = std::chrono::steady_clock::now();
     for (auto& casc : fullCasc) { //loop over cascades
 
       auto v0 = casc.v0_as<aod::V0Datas>();
@@ -202,13 +329,44 @@ struct strangenessFilter {
       QAHistos.fill(HIST("hMassXiBefSel"), casc.mXi());
       QAHistos.fill(HIST("hMassOmegaBefSel"), casc.mOmega());
 
-      //Position
-      xipos = TMath::Sqrt(TMath::Power(casc.x() - collision.posX(), 2) + TMath::Power(casc.y() - collision.posY(), 2) + TMath::Power(casc.z() - collision.posZ(), 2));
-      //Total momentum
-      xiptotmom = TMath::Sqrt(casc.px() * casc.px() + casc.py() * casc.py() + casc.pz() * casc.pz());
-      //Proper lifetime
-      xiproperlifetime = RecoDecay::getMassPDG(3312) * xipos / (xiptotmom + 1e-13);
-      omegaproperlifetime = RecoDecay::getMassPDG(3334) * xipos / (xiptotmom + 1e-13);
+      //Proper lifetime, compared on the squared decay length and momentum
+      const float xipos[3] = {casc.x(), casc.y(), casc.z()};
+      const float ximom[3] = {casc.px(), casc.py(), casc.pz()};
+      const float xipos2 = AliStrangenessKernels::Distance2(xipos, primVtx);
+      const float xiptotmom2 = AliStrangenessKernels::Mom2(ximom);
+      xiproperlifetime = AliStrangenessKernels::ProperLifetimeBelow(RecoDecay::getMassPDG(3312), xipos2, xiptotmom2, properlifetimefactor * ctauxi);
+      omegaproperlifetime = AliStrangenessKernels::ProperLifetimeBelow(RecoDecay::getMassPDG(3334), xipos2, xiptotmom2, properlifetimefactor * ctauomega);
+
+      //Omega candidates of the BDT: mass window and rapidity only, the cuts below are replaced by the model
+      if (omegaML && (TMath::Abs(casc.mOmega() - RecoDecay::getMassPDG(3334)) < omegamasswindow) && (TMath::Abs(casc.yOmega()) < rapidity)) {
+        const bool positive = casc.sign() == 1;
+        const auto& baryon = positive ? negdau : posdau;
+        const auto& meson = positive ? posdau : negdau;
+        omegaFeatures[kCascCosPA].push_back(casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()));
+        omegaFeatures[kV0CosPA].push_back(casc.v0cosPA(collision.posX(), collision.posY(), collision.posZ()));
+        omegaFeatures[kDCAV0ToPV].push_back(casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()));
+        omegaFeatures[kDCABachToPV].push_back(TMath::Abs(casc.dcabachtopv()));
+        omegaFeatures[kDCABaryonToPV].push_back(TMath::Abs(positive ? casc.dcanegtopv() : casc.dcapostopv()));
+        omegaFeatures[kDCAMesonToPV].push_back(TMath::Abs(positive ? casc.dcapostopv() : casc.dcanegtopv()));
+        omegaFeatures[kDCAV0Dau].push_back(casc.dcaV0daughters());
+        omegaFeatures[kDCACascDau].push_back(casc.dcacascdaughters());
+        omegaFeatures[kV0Radius].push_back(casc.v0radius());
+        omegaFeatures[kCascRadius].push_back(casc.cascradius());
+        omegaFeatures[kMassLambdaDiff].push_back(TMath::Abs(casc.mLambda() - constants::physics::MassLambda));
+        omegaFeatures[kMassXiDiff].push_back(TMath::Abs(casc.mXi() - RecoDecay::getMassPDG(3312)));
+        omegaFeatures[kCTauOmega].push_back(RecoDecay::getMassPDG(3334) * std::sqrt(xipos2 / xiptotmom2));
+        omegaFeatures[kYOmega].push_back(casc.yOmega());
+        omegaFeatures[kEta].push_back(casc.eta());
+        omegaFeatures[kTPCNSigmaBaryon].push_back(baryon.tpcNSigmaPr());
+        omegaFeatures[kTPCNSigmaMeson].push_back(meson.tpcNSigmaPi());
+        omegaFeatures[kTPCNSigmaBach].push_back(bachelor.tpcNSigmaPi());
+        omegaFeatures[kTOFNSigmaBaryon].push_back(baryon.tofNSigmaPr());
+        omegaFeatures[kTOFNSigmaMeson].push_back(meson.tofNSigmaPi());
+        omegaFeatures[kTOFNSigmaBach].push_back(bachelor.tofNSigmaPi());
+        omegaFeatures[kPt].push_back(casc.pt());
+        omegaMasses.push_back(casc.mOmega());
+        omegaPts.push_back(casc.pt());
+      }
 
       if (casc.sign() == 1) {
         if (TMath::Abs(casc.dcapostopv()) < dcamesontopv) {
@@ -295,27 +453,37 @@ struct strangenessFilter {
         continue;
       };
 
+      //Input of the cut optimiser: variables of the Xi cuts below, the other Xi cuts applied
+      if (cutCandidateOutput && (TMath::Abs(casc.mOmega() - RecoDecay::getMassPDG(3334)) > omegarej) && (TMath::Abs(casc.yXi()) < rapidity)) {
+        strgcutcands(collision.globalIndex(), casc.globalIndex(),
+                     casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()),
+                     casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()),
+                     TMath::Abs(casc.mXi() - RecoDecay::getMassPDG(3312)),
+                     RecoDecay::getMassPDG(3312) * std::sqrt(xipos2 / xiptotmom2) / ctauxi);
+      }
+
       isXi = (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospa) &&
              (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
              (TMath::Abs(casc.mXi() - RecoDecay::getMassPDG(3312)) < ximasswindow) &&
              (TMath::Abs(casc.mOmega() - RecoDecay::getMassPDG(3334)) > omegarej) &&
-             (xiproperlifetime < properlifetimefactor * ctauxi) &&
+             xiproperlifetime &&
              (TMath::Abs(casc.yXi()) < rapidity); //add PID on bachelor
       isXiYN = (casc.cascradius() > 24.39) &&
                (TMath::Abs(casc.mXi() - RecoDecay::getMassPDG(3312)) < ximasswindow) &&
                (TMath::Abs(casc.mOmega() - RecoDecay::getMassPDG(3334)) > omegarej) &&
-               (xiproperlifetime < properlifetimefactor * ctauxi) &&
+               xiproperlifetime &&
                (TMath::Abs(casc.yXi()) < rapidity); //add PID on bachelor
-      isOmega = (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospa) &&
+      isOmega = !omegaML &&
+                (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospa) &&
                 (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
                 (TMath::Abs(casc.mOmega() - RecoDecay::getMassPDG(3334)) < omegamasswindow) &&
                 (TMath::Abs(casc.mXi() - RecoDecay::getMassPDG(3312)) > xirej) &&
-                (omegaproperlifetime < properlifetimefactor * ctauomega) &&
+                omegaproperlifetime &&
                 (TMath::Abs(casc.yOmega()) < rapidity); //add PID on bachelor
 
       if (isXi) {
         QAHistos.fill(HIST("hMassXiAfterSel"), casc.mXi());
-        QAHistos.fill(HIST("hMassXiAfterSel2D"), casc.mXi(), casc.pt());
+        QAHistos.fill(HIST("hMassXiAfterSelvsPt"), casc.mXi(), casc.pt());
         //Count number of Xi candidates
         xicounter++;
       }
@@ -325,11 +493,41 @@ struct strangenessFilter {
       }
       if (isOmega) {
         QAHistos.fill(HIST("hMassOmegaAfterSel"), casc.mOmega());
-        QAHistos.fill(HIST("hMassOmegaAfterSel2D"), casc.mOmega(), casc.pt());
+        QAHistos.fill(HIST("hMassOmegaAfterSelvsPt"), casc.mOmega(), casc.pt());
         //Count number of Omega candidates
         omegacounter++;
       }
     } //end loop over cascades
+    auto loopEnd = std::chrono::steady_clock::now();
+    cascLoopSeconds += std::chrono::duration<double>(loopEnd - loopStart).count();
+    cascLoopCandidates += fullCasc.size();
+
+    //Omega BDT, all the candidates of the collision in one batch
+    if (omegaML && !omegaMasses.empty()) {
+      const int nOmega = omegaMasses.size();
+      //budget: the cut chain on the same features, timed for the comparison only
+      for (int i = 0; i < nOmega; i++) {
+        omegaCutSelected += passesOmegaCuts(i, properlifetimefactor * ctauomega);
+      }
+      auto mlStart = std::chrono::steady_clock::now();
+      omegaCutSeconds += std::chrono::duration<double>(mlStart - loopEnd).count();
+      const float* features[kNOmegaFeatures];
+      for (int f = 0; f < kNOmegaFeatures; f++) {
+        features[f] = omegaFeatures[f].data();
+      }
+      omegaMargins.resize(nOmega);
+      omegaBDT.predict(nOmega, features, omegaMargins.data());
+      omegaMLSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - mlStart).count();
+      omegaMLCandidates += nOmega;
+      for (int i = 0; i < nOmega; i++) {
+        if (omegaBDT.response(omegaMargins[i]) > omegaMLThreshold) {
+          QAHistos.fill(HIST("hMassOmegaAfterSel"), omegaMasses[i]);
+          QAHistos.fill(HIST("hMassOmegaAfterSelvsPt"), omegaMasses[i], omegaPts[i]);
+          omegacounter++;
+          omegaMLSelected++;
+        }
+      }
+    }
 
     //Omega trigger definition
     if (omegacounter > 0) {
@@ -392,9 +590,46 @@ struct strangenessFilter {
       EventsvsMultiplicity.fill(HIST("SingleXiEventsvsMultiplicity"), collision.centV0M());
     }
 
-    //Filling the table
-    strgtable(keepEvent[0], keepEvent[1], keepEvent[2], keepEvent[3], keepEvent[4], keepEvent[5]);
+    //Downscaling, after the QA: the histograms count the triggers before it
+    uint32_t decisions = aod::PackDecisions(keepEvent);
+    if (rateControl && decisions) {
+      auto bc = collision.bc();
+      decisions = rateController.apply(bc.globalBC(), decisions);
+      for (auto& adjustment : rateController.adjustments()) {
+        strgratecontrols(bc.runNumber(), adjustment.globalBC, adjustment.bit, adjustment.rawRate, adjustment.downscale);
+      }
+      rateController.clearAdjustments();
+      for (int i = 0; i < 6; i++) {
+        keepEvent[i] = (decisions >> i) & 1;
+      }
+    }
+
+    //Filling the tables
+    if (denseOutput) {
+      strgtable(keepEvent[0], keepEvent[1], keepEvent[2], keepEvent[3], keepEvent[4], keepEvent[5]);
+    }
+    if (sparseOutput && decisions) {
+      strgsparsetable(collision.globalIndex(), decisions);
+    }
+    if (doprocessBitmapIndex && decisions) {
+      bitmapIndexHits.emplace_back(collision.globalIndex(), decisions);
+    }
+  }
+
+  //Number of inspected collisions of the data frame, for the normalisation of the sparse table
+  void processSummary(aod::Collisions const& collisions, aod::BCs const&)
+  {
+    strgsummary(collisions.size() ? collisions.begin().bc().runNumber() : -1, collisions.size());
+  }
+  PROCESS_SWITCH(strangenessFilter, processSummary, "Write the inspected collisions per data frame", true);
+
+  //Adds the data frame to the trigger index; called after process, which collected its triggered collisions
+  void processBitmapIndex(aod::Collisions const& collisions, aod::Origins const& origins)
+  {
+    bitmapIndex.addDataFrame(origins.size() ? origins.begin().dataframeID() : 0, collisions.size(), bitmapIndexHits);
+    bitmapIndexHits.clear();
   }
+  PROCESS_SWITCH(strangenessFilter, processBitmapIndex, "Write the sidecar trigger index (bitmapIndexFile)", false);
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
@@ -13,6 +13,7 @@
 /*  
   o2-analysis-timestamp -b --aod-file AO2D.root   | \
   o2-analysis-event-selection -b | \
+  o2-analysis-strangeness-event-selection -b | \
   o2-analysis-trackselection -b | \
   o2-analysis-trackextension -b | \
   o2-analysis-multiplicity-table -b | \
@@ -54,7 +55,12 @@
 #include <cstdlib>
 #include "Framework/ASoAHelpers.h"
 
+#include "Framework/CallbackService.h"
+#include "Framework/EndOfStreamContext.h"
+
 #include "../filterTables.h"
+#include "../triggerBitmapIndex.h"
+#include "../AliStrangenessKernels.h"
 
 using namespace o2;
 using namespace o2::framework;
@@ -65,13 +71,24 @@ struct strangenessFilterK0s {
 
   //Recall the output table
   Produces<aod::StrangenessFiltersK0s> strgtableK0s;
+  Produces<aod::StrangenessSparseFiltersK0s> strgsparsetableK0s;
+  Produces<aod::StrangenessFilterSummariesK0s> strgsummaryK0s;
 
   //Define a histograms and registries
   HistogramRegistry QAHistos{"QAHistos", {}, OutputObjHandlingPolicy::AnalysisObject, true, true};
   OutputObj<TH1F> hProcessedEvents{TH1F("hProcessedEvents", "Strangeness - event filtered; Event counter; Number of events", 3, 0., 3.)};
 
+  Configurable<bool> denseOutput{"denseOutput", true, "Write one StrangenessFiltersK0s row per collision"};
+  Configurable<bool> sparseOutput{"sparseOutput", true, "Write StrangenessSparseFiltersK0s rows for the triggered collisions only"};
+  Configurable<std::string> bitmapIndexFile{"bitmapIndexFile", "strangenessK0sTriggerIndex.bin", "Sidecar trigger index, written at the end of the stream (processBitmapIndex)"};
+
+  //Trigger index: bitmaps of the triggered collisions and data frames with hits, filled per data frame
+  o2::filtering::TriggerBitmapIndex bitmapIndex{{"DoubleK0s", "hadronK0s"}};
+  std::vector<std::pair<uint32_t, uint32_t>> bitmapIndexHits; // (collision row, decisions) of the current data frame
+
   //Selection criteria for V0s
   Configurable<float> cutzvertex{"cutzvertex", 10.0f, "Accepted z-vertex range"};
+  Configurable<int> minEvSelLevel{"minEvSelLevel", aod::kEvSelINT7, "Min StrangenessEvSelLevel in the collision Filter (0: selection in process, for timing comparisons)"};
   Configurable<float> v0cospa{"v0cospa", 0.995, "V0 CosPA"}; //is it with respect to Xi decay vertex? 
   Configurable<float> dcav0dau{"dcav0dau", 1, "DCA V0 Daughters"};       //is it in sigmas?
   Configurable<float> dcanegtopv{"dcanegtopv", 0.06, "DCA Neg To PV"};
@@ -93,8 +110,15 @@ struct strangenessFilterK0s {
   Configurable<float> hEta{"hEta", 0.8f, "Eta range for trigger particles"};
   Configurable<float> hMinPt{"hMinPt", 1.0f, "Min pt for trigger particles"};
 
-  void init(o2::framework::InitContext&)
+  void init(o2::framework::InitContext& ic)
   {
+    if (doprocessBitmapIndex) {
+      ic.services().get<CallbackService>().set(CallbackService::Id::EndOfStream, [this](EndOfStreamContext&) {
+        if (!bitmapIndex.write(bitmapIndexFile.value)) {
+          LOGF(error, "Cannot write the trigger index to %s", bitmapIndexFile.value);
+        }
+      });
+    }
 
     //  std::vector<double> ptBinning = {0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 1.6, 1.8, 2.0, 2.2, 2.4, 2.8, 3.2, 3.6, 4., 5., 10., 20.};
     //  AxisSpec ptAxis = {ptBinning, "#it{p}_{T} (GeV/#it{c})"};
@@ -114,13 +138,13 @@ struct strangenessFilterK0s {
   }
 
   //Filters
-  Filter collisionFilter = (nabs(aod::collision::posZ) < cutzvertex);
+  Filter collisionFilter = (nabs(aod::collision::posZ) < cutzvertex) && (aod::filtering::evSelLevel >= minEvSelLevel);
   Filter trackFilter = (nabs(aod::track::eta) < hEta) && (aod::track::isGlobalTrack == static_cast<uint8_t>(1u)) && (aod::track::pt>hMinPt); 
   Filter preFilterV0 = nabs(aod::v0data::dcapostopv) > dcapostopv&& nabs(aod::v0data::dcanegtopv) > dcanegtopv&& aod::v0data::dcaV0daughters < dcav0dau;
 
   //Tables
   
-  using CollisionCandidates = soa::Filtered<soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms>>::iterator;
+  using CollisionCandidates = soa::Filtered<soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms, aod::StrangenessEvSels>>::iterator;
   //using CollisionCandidates = soa::Join<aod::Collisions, aod::EvSels, aod::CentV0Ms>::iterator;
   using DaughterTracks = soa::Join<aod::Tracks, aod::TracksExtra, aod::pidTOFPi, aod::pidTPCPi, aod::pidTOFPr, aod::pidTPCPr>;
   using TrackCandidates = soa::Filtered<soa::Join<aod::Tracks, aod::TracksExtra, aod::TrackSelection>>;
@@ -129,12 +153,10 @@ struct strangenessFilterK0s {
  
   {
 
-    if (!collision.alias()[kINT7]) {
+    // already applied by collisionFilter, unless minEvSelLevel is lowered (sel7 not required)
+    if (collision.evSelLevel() < aod::kEvSelINT7) {
       return;
     }
-    if (!collision.sel7()) { 
-      //      return;
-    }
 
     QAHistos.fill(HIST("VtxZAfterSel"), collision.posZ());
     QAHistos.fill(HIST("Centrality"), collision.centV0M());
@@ -143,9 +165,7 @@ struct strangenessFilterK0s {
     //Is event good? [0] = DoubleK0s, [1] = high-pT hadron + K0s
     bool keepEvent[2]{false};
     //
-    float v0pos = -1.;
-    float K0sproperlifetime = -1.;
-    float v0ptotmom = -1.;
+    const float primVtx[3] = {collision.posX(), collision.posY(), collision.posZ()};
     int K0scounter = 0;
     const float ctauK0s = 2.6844;   //from PDG
     const float massK0s = 0.497611; //from PDG
@@ -157,12 +177,10 @@ struct strangenessFilterK0s {
       if (TMath::Abs(v0.mK0Short() - massK0s) > k0smasswindow) continue;      
       QAHistos.fill(HIST("hMassK0sBefSel"), v0.mK0Short());
 
-      //Position
-      v0pos = TMath::Sqrt(TMath::Power(v0.x() - collision.posX(), 2) + TMath::Power(v0.y() - collision.posY(), 2) + TMath::Power(v0.z() - collision.posZ(), 2));
-      //Total momentum
-      v0ptotmom = TMath::Sqrt(v0.px() * v0.px() + v0.py() * v0.py() + v0.pz() * v0.pz());
-      //Proper lifetime
-      K0sproperlifetime = massK0s * v0pos / (v0ptotmom + 1e-13);
+      //Proper lifetime, compared on the squared decay length and momentum
+      const float v0pos[3] = {v0.x(), v0.y(), v0.z()};
+      const float v0mom[3] = {v0.px(), v0.py(), v0.pz()};
+      const bool K0sproperlifetime = AliStrangenessKernels::ProperLifetimeBelow(massK0s, AliStrangenessKernels::Distance2(v0pos, primVtx), AliStrangenessKernels::Mom2(v0mom), properlifetimefactor * ctauK0s);
 
       if (TMath::Abs(v0.posTrack_as<DaughterTracks>().tpcNSigmaPi()) > 3.0) continue;
       if (TMath::Abs(v0.negTrack_as<DaughterTracks>().tpcNSigmaPi()) > 3.0) continue;
@@ -173,7 +191,7 @@ struct strangenessFilterK0s {
       if (v0.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) continue;
       if (v0.v0cosPA(collision.posX(), collision.posY(), collision.posZ()) < v0cospa) continue;
       if (TMath::Abs(v0.mLambda() - constants::physics::MassLambda) < LRej) continue;
-      if (K0sproperlifetime > properlifetimefactor * ctauK0s) continue;
+      if (!K0sproperlifetime) continue;
       QAHistos.fill(HIST("hMassK0sAfterSel"), v0.mK0Short());
 
       //Count number of K0s candidates
@@ -221,9 +239,33 @@ struct strangenessFilterK0s {
     if (keepEvent[1])
       hProcessedEvents->Fill(2.5);
     
-    //Filling the table
-    strgtableK0s(keepEvent[0],keepEvent[1]);
+    //Filling the tables
+    if (denseOutput) {
+      strgtableK0s(keepEvent[0],keepEvent[1]);
+    }
+    uint32_t decisions = aod::PackDecisions(keepEvent);
+    if (sparseOutput && decisions) {
+      strgsparsetableK0s(collision.globalIndex(), decisions);
+    }
+    if (doprocessBitmapIndex && decisions) {
+      bitmapIndexHits.emplace_back(collision.globalIndex(), decisions);
+    }
+  }
+
+  //Number of inspected collisions of the data frame, for the normalisation of the sparse table
+  void processSummary(aod::Collisions const& collisions, aod::BCs const&)
+  {
+    strgsummaryK0s(collisions.size() ? collisions.begin().bc().runNumber() : -1, collisions.size());
+  }
+  PROCESS_SWITCH(strangenessFilterK0s, processSummary, "Write the inspected collisions per data frame", true);
+
+  //Adds the data frame to the trigger index; called after process, which collected its triggered collisions
+  void processBitmapIndex(aod::Collisions const& collisions, aod::Origins const& origins)
+  {
+    bitmapIndex.addDataFrame(origins.size() ? origins.begin().dataframeID() : 0, collisions.size(), bitmapIndexHits);
+    bitmapIndexHits.clear();
   }
+  PROCESS_SWITCH(strangenessFilterK0s, processBitmapIndex, "Write the sidecar trigger index (bitmapIndexFile)", false);
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
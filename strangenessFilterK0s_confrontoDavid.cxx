@@ -53,6 +53,7 @@
 #include "Framework/ASoAHelpers.h"
 
 #include "../filterTables.h"
+#include "../AliStrangenessKernels.h"
 
 using namespace o2;
 using namespace o2::framework;
@@ -170,9 +171,8 @@ struct strangenessFilterK0s {
     //Is event good? [0] = DoubleK0s, [1] = high-pT hadron + K0s
     bool keepEvent[2]{false};
     //
-    float v0pos = -1.;
+    const float primVtx[3] = {collision.posX(), collision.posY(), collision.posZ()};
     float K0sproperlifetime = -1.;
-    float v0ptotmom = -1.;
     int K0scounter = 0;
     const float ctauK0s = 2.6844;   //from PDG
     const float massK0s = 0.497611; //from PDG
@@ -189,12 +189,10 @@ struct strangenessFilterK0s {
     
     for (auto& v0 : fullV0) { //loop over V0s
      
-      //Position
-      v0pos = TMath::Sqrt(TMath::Power(v0.x() - collision.posX(), 2) + TMath::Power(v0.y() - collision.posY(), 2) + TMath::Power(v0.z() - collision.posZ(), 2));
-      //Total momentum
-      v0ptotmom = TMath::Sqrt(v0.px() * v0.px() + v0.py() * v0.py() + v0.pz() * v0.pz());
       //Proper lifetime
-      K0sproperlifetime = massK0s * v0pos / (v0ptotmom + 1e-13);
+      const float v0pos[3] = {v0.x(), v0.y(), v0.z()};
+      const float v0mom[3] = {v0.px(), v0.py(), v0.pz()};
+      K0sproperlifetime = massK0s * AliStrangenessKernels::DistOverTotMom(v0pos, primVtx, v0mom);
 
       //Bef selections
       QAHistos.fill(HIST("hMassK0sBefSel"), v0.mK0Short());
@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_ANALYSIS_STRANGENESS_SKIM_H_
+#define O2_ANALYSIS_STRANGENESS_SKIM_H_
+
+#include "Framework/AnalysisDataModel.h"
+
+namespace o2::aod
+{
+namespace strskim
+{
+// collisions
+DECLARE_SOA_COLUMN(PosX, posX, float);              //!
+DECLARE_SOA_COLUMN(PosY, posY, float);              //!
+DECLARE_SOA_COLUMN(PosZ, posZ, float);              //!
+DECLARE_SOA_COLUMN(Decisions, decisions, uint32_t); //! decision word of StrangenessSparseFilters
+
+// daughter tracks, parameters at the innermost point
+DECLARE_SOA_INDEX_COLUMN(StrSkimColl, strSkimColl); //! -1 if the collision of the track was not triggered
+DECLARE_SOA_COLUMN(X, x, float);                    //!
+DECLARE_SOA_COLUMN(Alpha, alpha, float);            //!
+DECLARE_SOA_COLUMN(Y, y, float);                    //!
+DECLARE_SOA_COLUMN(Z, z, float);                    //!
+DECLARE_SOA_COLUMN(Snp, snp, float);                //!
+DECLARE_SOA_COLUMN(Tgl, tgl, float);                //!
+DECLARE_SOA_COLUMN(Signed1Pt, signed1Pt, float);    //!
+
+// V0s and cascades, indices into the skimmed tables
+DECLARE_SOA_INDEX_COLUMN_FULL(PosTrack, posTrack, int, StrSkimTracks, "_Pos"); //!
+DECLARE_SOA_INDEX_COLUMN_FULL(NegTrack, negTrack, int, StrSkimTracks, "_Neg"); //!
+DECLARE_SOA_INDEX_COLUMN_FULL(Bachelor, bachelor, int, StrSkimTracks, "");     //!
+DECLARE_SOA_INDEX_COLUMN(StrSkimV0, strSkimV0);                                //!
+
+// bookkeeping
+DECLARE_SOA_COLUMN(SkimSeconds, skimSeconds, float); //! time spent skimming the data frame
+} // namespace strskim
+
+DECLARE_SOA_TABLE(StrSkimColls, "AOD", "STRSKIMCOLL", //! triggered collisions
+                  o2::soa::Index<>, strskim::PosX, strskim::PosY, strskim::PosZ, strskim::Decisions);
+using StrSkimColl = StrSkimColls::iterator;
+
+// parameters, covariance (as in TracksCov) and extra information (as in TracksExtra): enough to
+// refit the V0s and cascades from their daughters
+DECLARE_SOA_TABLE(StrSkimTracks, "AOD", "STRSKIMTRACK", //! daughters of the skimmed V0s and cascades
+                  o2::soa::Index<>, strskim::StrSkimCollId, strskim::X, strskim::Alpha,
+                  strskim::Y, strskim::Z, strskim::Snp, strskim::Tgl, strskim::Signed1Pt,
+                  track::SigmaY, track::SigmaZ, track::SigmaSnp, track::SigmaTgl, track::Sigma1Pt,
+                  track::RhoZY, track::RhoSnpY, track::RhoSnpZ, track::RhoTglY, track::RhoTglZ,
+                  track::RhoTglSnp, track::Rho1PtY, track::Rho1PtZ, track::Rho1PtSnp, track::Rho1PtTgl,
+                  track::TPCInnerParam, track::Flags, track::ITSClusterMap,
+                  track::TPCNClsFindable, track::TPCNClsFindableMinusFound, track::TPCNClsFindableMinusCrossedRows,
+                  track::TPCNClsShared, track::TRDPattern, track::ITSChi2NCl,
+                  track::TPCChi2NCl, track::TRDChi2, track::TOFChi2,
+                  track::TPCSignal, track::TRDSignal, track::TOFSignal, track::Length, track::TOFExpMom,
+                  track::TrackEtaEMCAL, track::TrackPhiEMCAL);
+using StrSkimTrack = StrSkimTracks::iterator;
+
+DECLARE_SOA_TABLE(StrSkimV0s, "AOD", "STRSKIMV0", //! V0s of the triggered collisions
+                  o2::soa::Index<>, strskim::StrSkimCollId, strskim::PosTrackId, strskim::NegTrackId);
+using StrSkimV0 = StrSkimV0s::iterator;
+
+DECLARE_SOA_TABLE(StrSkimCascs, "AOD", "STRSKIMCASC", //! cascades of the triggered collisions
+                  o2::soa::Index<>, strskim::StrSkimCollId, strskim::StrSkimV0Id, strskim::BachelorId);
+using StrSkimCasc = StrSkimCascs::iterator;
+
+DECLARE_SOA_TABLE(StrSkimTimes, "AOD", "STRSKIMTIME", //! one row per data frame, not meant to be written
+                  strskim::SkimSeconds);
+
+} // namespace o2::aod
+
+#endif // O2_ANALYSIS_STRANGENESS_SKIM_H_
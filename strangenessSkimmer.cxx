@@ -0,0 +1,286 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+/// \brief Skim of the collisions selected by the strangeness triggers
+//  usage:
+/*
+  ... | o2-analysis-lambdakzerobuilder --d_bz 5 -b | \
+  o2-analysis-cascadebuilder --d_bz 5 -b | \
+  o2-analysis-strangeness-filter -b | \
+  o2-analysis-strangeness-skimmer -b --aod-writer-keep AOD/STRSKIMCOLL/0,AOD/STRSKIMTRACK/0,AOD/STRSKIMV0/0,AOD/STRSKIMCASC/0
+*/
+///  Driven by the sparse decisions of the strangeness filter (StrangenessSparseFilters): writes
+///  the triggered collisions, their V0s and cascades and only the daughter tracks these
+///  reference, with parameters, covariance and extra information, and with the indices
+///  remapped to the skimmed tables (strangenessSkimTables.h). Rows keep their input order and
+///  are copied row by row: the remapped index columns cannot be slices of the input.
+///  lf-strangeness-skim-size receives the skimmed tables as they go to the writer and reports
+///  their size (Arrow buffers) per trigger class and the skim throughput, MB/s written over
+///  the time of lf-strangeness-skimmer (StrSkimTimes).
+///
+/// \author Francesca Ercolessi (francesca.ercolessi@cern.ch)
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/AnalysisTask.h"
+#include "Framework/AnalysisDataModel.h"
+#include "Framework/CallbackService.h"
+#include "Framework/EndOfStreamContext.h"
+#include "Common/DataModel/StrangenessTables.h"
+
+#include <arrow/table.h>
+#include <TH1D.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "../filterTables.h"
+#include "../strangenessSkimTables.h"
+
+using namespace o2;
+using namespace o2::framework;
+
+namespace
+{
+constexpr int kNTriggers = 6;
+
+/// bytes of the Arrow buffers of a table
+int64_t arrowBytes(std::shared_ptr<arrow::Table> const& table)
+{
+  int64_t bytes = 0;
+  for (auto& column : table->columns()) {
+    for (auto& chunk : column->chunks()) {
+      for (auto& buffer : chunk->data()->buffers) {
+        bytes += buffer ? buffer->size() : 0;
+      }
+    }
+  }
+  return bytes;
+}
+} // namespace
+
+struct strangenessSkimmer {
+
+  Produces<aod::StrSkimColls> skimColls;
+  Produces<aod::StrSkimTracks> skimTracks;
+  Produces<aod::StrSkimV0s> skimV0s;
+  Produces<aod::StrSkimCascs> skimCascs;
+  Produces<aod::StrSkimTimes> skimTimes;
+
+  OutputObj<TH1D> hSkimRows{TH1D("hSkimRows", "Skimmed rows; ; Rows", 4, 0., 4.)};
+
+  using DaughterTracks = soa::Join<aod::Tracks, aod::TracksCov, aod::TracksExtra>;
+
+  void init(InitContext const&)
+  {
+    const char* rows[4] = {"Collisions", "Tracks", "V0s", "Cascades"};
+    for (int i = 0; i < 4; i++) {
+      hSkimRows->GetXaxis()->SetBinLabel(i + 1, rows[i]);
+    }
+  }
+
+  void process(aod::StrangenessSparseFilters const& triggers, aod::Collisions const& collisions, aod::V0Datas const& v0s, aod::CascDataExt const& cascades, DaughterTracks const& tracks)
+  {
+    auto start = std::chrono::steady_clock::now();
+    skim(triggers, collisions, v0s, cascades, tracks);
+    skimTimes(std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count());
+  }
+
+  void skim(aod::StrangenessSparseFilters const& triggers, aod::Collisions const& collisions, aod::V0Datas const& v0s, aod::CascDataExt const& cascades, DaughterTracks const& tracks)
+  {
+    // collisions: skimmed index in input order
+    std::vector<int> collIndex(collisions.size(), -1);
+    std::vector<uint32_t> collDecisions(collisions.size(), 0);
+    for (auto& trigger : triggers) {
+      collDecisions[trigger.collisionId()] |= trigger.decisions();
+    }
+    int nColls = 0;
+    for (int i = 0; i < (int)collisions.size(); i++) {
+      if (collDecisions[i]) {
+        collIndex[i] = nColls++;
+      }
+    }
+    if (!nColls) {
+      return;
+    }
+
+    // candidates of the triggered collisions, and the tracks they reference
+    std::vector<int> v0Index(v0s.size(), -1), cascIndex(cascades.size(), -1), trackIndex(tracks.size(), -1);
+    for (auto& v0 : v0s) {
+      int coll = v0.collisionId();
+      if (coll < 0 || !collDecisions[coll]) {
+        continue;
+      }
+      v0Index[v0.globalIndex()] = 0;
+      trackIndex[v0.posTrackId()] = trackIndex[v0.negTrackId()] = 0;
+    }
+    for (auto& casc : cascades) {
+      int coll = casc.collisionId();
+      if (coll < 0 || !collDecisions[coll]) {
+        continue;
+      }
+      cascIndex[casc.globalIndex()] = 0;
+      if (v0Index[casc.v0Id()] < 0) {
+        // V0 of the cascade from another collision: kept, with its daughters, so that the
+        // cascade can be rebuilt
+        auto v0 = v0s.rawIteratorAt(casc.v0Id());
+        v0Index[casc.v0Id()] = 0;
+        trackIndex[v0.posTrackId()] = trackIndex[v0.negTrackId()] = 0;
+      }
+      trackIndex[casc.bachelorId()] = 0;
+    }
+    for (int i = 0, n = 0; i < (int)tracks.size(); i++) {
+      if (trackIndex[i] >= 0) {
+        trackIndex[i] = n++;
+      }
+    }
+    for (int i = 0, n = 0; i < (int)v0s.size(); i++) {
+      if (v0Index[i] >= 0) {
+        v0Index[i] = n++;
+      }
+    }
+    for (int i = 0, n = 0; i < (int)cascades.size(); i++) {
+      if (cascIndex[i] >= 0) {
+        cascIndex[i] = n++;
+      }
+    }
+
+    // selected rows in input order, indices remapped
+    for (int i = 0; i < (int)collisions.size(); i++) {
+      if (collIndex[i] >= 0) {
+        auto coll = collisions.rawIteratorAt(i);
+        skimColls(coll.posX(), coll.posY(), coll.posZ(), collDecisions[i]);
+      }
+    }
+    int nTracks = 0, nV0s = 0, nCascs = 0;
+    for (int i = 0; i < (int)tracks.size(); i++) {
+      if (trackIndex[i] < 0) {
+        continue;
+      }
+      auto track = tracks.rawIteratorAt(i);
+      int coll = track.collisionId();
+      skimTracks(coll >= 0 ? collIndex[coll] : -1, track.x(), track.alpha(), track.y(), track.z(), track.snp(), track.tgl(), track.signed1Pt(),
+                 track.sigmaY(), track.sigmaZ(), track.sigmaSnp(), track.sigmaTgl(), track.sigma1Pt(),
+                 track.rhoZY(), track.rhoSnpY(), track.rhoSnpZ(), track.rhoTglY(), track.rhoTglZ(),
+                 track.rhoTglSnp(), track.rho1PtY(), track.rho1PtZ(), track.rho1PtSnp(), track.rho1PtTgl(),
+                 track.tpcInnerParam(), track.flags(), track.itsClusterMap(),
+                 track.tpcNClsFindable(), track.tpcNClsFindableMinusFound(), track.tpcNClsFindableMinusCrossedRows(),
+                 track.tpcNClsShared(), track.trdPattern(), track.itsChi2NCl(),
+                 track.tpcChi2NCl(), track.trdChi2(), track.tofChi2(),
+                 track.tpcSignal(), track.trdSignal(), track.tofSignal(), track.length(), track.tofExpMom(),
+                 track.trackEtaEmcal(), track.trackPhiEmcal());
+      nTracks++;
+    }
+    for (int i = 0; i < (int)v0s.size(); i++) {
+      if (v0Index[i] < 0) {
+        continue;
+      }
+      auto v0 = v0s.rawIteratorAt(i);
+      int coll = v0.collisionId();
+      skimV0s(coll >= 0 ? collIndex[coll] : -1, trackIndex[v0.posTrackId()], trackIndex[v0.negTrackId()]);
+      nV0s++;
+    }
+    for (int i = 0; i < (int)cascades.size(); i++) {
+      if (cascIndex[i] < 0) {
+        continue;
+      }
+      auto casc = cascades.rawIteratorAt(i);
+      skimCascs(collIndex[casc.collisionId()], v0Index[casc.v0Id()], trackIndex[casc.bachelorId()]);
+      nCascs++;
+    }
+
+    hSkimRows->Fill(0.5, nColls);
+    hSkimRows->Fill(1.5, nTracks);
+    hSkimRows->Fill(2.5, nV0s);
+    hSkimRows->Fill(3.5, nCascs);
+  }
+};
+
+/// Size of the skimmed tables, as sent to the writer, and skim throughput
+struct strangenessSkimSize {
+
+  OutputObj<TH1D> hSkimBytes{TH1D("hSkimBytes", "Skimmed bytes per trigger class; ; Bytes", kNTriggers, 0., kNTriggers)};
+
+  double skimSeconds = 0.;
+  double skimBytes = 0.;
+
+  void init(o2::framework::InitContext& ic)
+  {
+    const char* triggers[kNTriggers] = {"#Omega", "high-#it{p}_{T} hadron - #Xi", "2#Xi", "3#Xi", "4#Xi", "single-#Xi"};
+    for (int i = 0; i < kNTriggers; i++) {
+      hSkimBytes->GetXaxis()->SetBinLabel(i + 1, triggers[i]);
+    }
+    ic.services().get<CallbackService>().set(CallbackService::Id::EndOfStream, [this](EndOfStreamContext&) {
+      LOGF(info, "Strangeness skim: %.1f MB written in %.2f s of skimming, %.1f MB/s", skimBytes / 1.e6, skimSeconds, skimSeconds > 0. ? skimBytes / 1.e6 / skimSeconds : 0.);
+      for (int i = 0; i < kNTriggers; i++) {
+        LOGF(info, "Strangeness skim: %-30s %10.1f kB", hSkimBytes->GetXaxis()->GetBinLabel(i + 1), hSkimBytes->GetBinContent(i + 1) / 1024.);
+      }
+    });
+  }
+
+  /// a row of each table is accounted with the mean row size of its table: the candidates to
+  /// their collision, the V0 of a cascade from another collision and the tracks to the first
+  /// collision that uses them
+  void process(aod::StrSkimColls const& colls, aod::StrSkimTracks const& tracks, aod::StrSkimV0s const& v0s, aod::StrSkimCascs const& cascs, aod::StrSkimTimes const& times)
+  {
+    for (auto& time : times) {
+      skimSeconds += time.skimSeconds();
+    }
+    const int64_t collBytes = arrowBytes(colls.asArrowTable()), trackBytes = arrowBytes(tracks.asArrowTable());
+    const int64_t v0Bytes = arrowBytes(v0s.asArrowTable()), cascBytes = arrowBytes(cascs.asArrowTable());
+    skimBytes += collBytes + trackBytes + v0Bytes + cascBytes;
+    if (!colls.size()) {
+      return;
+    }
+
+    std::vector<double> bytes(colls.size(), double(collBytes) / colls.size());
+    std::vector<int> v0Owner(v0s.size(), -1), trackOwner(tracks.size(), -1);
+    for (auto& v0 : v0s) {
+      v0Owner[v0.globalIndex()] = v0.strSkimCollId();
+    }
+    for (auto& casc : cascs) {
+      bytes[casc.strSkimCollId()] += double(cascBytes) / cascs.size();
+      if (v0Owner[casc.strSkimV0Id()] < 0) {
+        v0Owner[casc.strSkimV0Id()] = casc.strSkimCollId();
+      }
+    }
+    auto useTrack = [&](int track, int coll) {
+      if (trackOwner[track] < 0) {
+        trackOwner[track] = coll;
+        bytes[coll] += double(trackBytes) / tracks.size();
+      }
+    };
+    for (auto& v0 : v0s) {
+      int coll = v0Owner[v0.globalIndex()];
+      if (coll < 0) {
+        continue;
+      }
+      bytes[coll] += double(v0Bytes) / v0s.size();
+      useTrack(v0.posTrackId(), coll);
+      useTrack(v0.negTrackId(), coll);
+    }
+    for (auto& casc : cascs) {
+      useTrack(casc.bachelorId(), casc.strSkimCollId());
+    }
+    for (auto& coll : colls) {
+      for (int t = 0; t < kNTriggers; t++) {
+        if (coll.decisions() >> t & 1) {
+          hSkimBytes->Fill(t + 0.5, bytes[coll.globalIndex()]);
+        }
+      }
+    }
+  }
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  return WorkflowSpec{
+    adaptAnalysisTask<strangenessSkimmer>(cfgc, TaskName{"lf-strangeness-skimmer"}),
+    adaptAnalysisTask<strangenessSkimSize>(cfgc, TaskName{"lf-strangeness-skim-size"})};
+}
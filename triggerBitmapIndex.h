@@ -0,0 +1,364 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file triggerBitmapIndex.h
+/// \brief Sidecar index of the trigger decisions for selective reading of the filtered AO2Ds.
+///
+/// For each trigger bit, a compressed bitmap of the positions of the triggered collisions and
+/// the list of data frames with at least one of them. Positions run over the collisions of all
+/// the data frames in processing order; the data frame table maps them back to the DF_<id>
+/// directory of the AO2D and to the row of the collision inside it.
+/// The bitmaps are roaring-style: the positions are split in chunks of 2^16, each stored as a
+/// sorted array of the low 16 bits (up to 4096 entries) or as a 2^16-bit bitset.
+/// No O2 or ROOT dependency, so that the readers can use it from plain macros.
+
+#ifndef O2_ANALYSIS_TRIGGER_BITMAP_INDEX_H_
+#define O2_ANALYSIS_TRIGGER_BITMAP_INDEX_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace o2::filtering
+{
+
+class RoaringBitmap
+{
+ public:
+  void add(uint32_t x)
+  {
+    Container& c = container(x >> 16);
+    uint16_t low = x & 0xFFFF;
+    if (c.isBitset()) {
+      c.words[low >> 6] |= uint64_t(1) << (low & 63);
+      return;
+    }
+    auto it = std::lower_bound(c.values.begin(), c.values.end(), low);
+    if (it != c.values.end() && *it == low) {
+      return;
+    }
+    c.values.insert(it, low);
+    if (c.values.size() > kMaxArraySize) {
+      c.toBitset();
+    }
+  }
+
+  bool contains(uint32_t x) const
+  {
+    const Container* c = find(x >> 16);
+    if (!c) {
+      return false;
+    }
+    uint16_t low = x & 0xFFFF;
+    if (c->isBitset()) {
+      return (c->words[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(c->values.begin(), c->values.end(), low);
+  }
+
+  uint64_t cardinality() const
+  {
+    uint64_t n = 0;
+    for (const auto& c : mContainers) {
+      n += c.cardinality();
+    }
+    return n;
+  }
+
+  /// calls f(position) in increasing order
+  template <typename F>
+  void forEach(F&& f) const
+  {
+    for (const auto& c : mContainers) {
+      uint32_t high = uint32_t(c.key) << 16;
+      if (c.isBitset()) {
+        for (uint32_t w = 0; w < c.words.size(); w++) {
+          for (uint64_t word = c.words[w]; word; word &= word - 1) {
+            f(high | (w << 6) | uint32_t(__builtin_ctzll(word)));
+          }
+        }
+      } else {
+        for (uint16_t low : c.values) {
+          f(high | low);
+        }
+      }
+    }
+  }
+
+  /// positions in [first, first + n), in increasing order
+  std::vector<uint32_t> range(uint32_t first, uint32_t n) const
+  {
+    std::vector<uint32_t> result;
+    const uint64_t end = uint64_t(first) + n;
+    auto it = std::lower_bound(mContainers.begin(), mContainers.end(), uint16_t(first >> 16), [](const Container& c, uint16_t k) { return c.key < k; });
+    for (; it != mContainers.end() && (uint64_t(it->key) << 16) < end; ++it) {
+      const uint32_t high = uint32_t(it->key) << 16;
+      // bounds of the range inside the chunk, [lo, hi)
+      const uint32_t lo = first > high ? first - high : 0;
+      const uint32_t hi = uint32_t(std::min<uint64_t>(end - high, 1 << 16));
+      if (it->isBitset()) {
+        for (uint32_t w = lo >> 6; w < (hi + 63) >> 6; w++) {
+          uint64_t word = it->words[w];
+          if (w == lo >> 6) {
+            word &= ~uint64_t(0) << (lo & 63);
+          }
+          if (w == (hi - 1) >> 6 && (hi & 63)) {
+            word &= ~(~uint64_t(0) << (hi & 63));
+          }
+          for (; word; word &= word - 1) {
+            result.push_back(high | (w << 6) | uint32_t(__builtin_ctzll(word)));
+          }
+        }
+      } else {
+        for (auto v = std::lower_bound(it->values.begin(), it->values.end(), lo); v != it->values.end() && *v < hi; ++v) {
+          result.push_back(high | *v);
+        }
+      }
+    }
+    return result;
+  }
+
+  void write(std::ostream& out) const
+  {
+    writeValue(out, uint32_t(mContainers.size()));
+    for (const auto& c : mContainers) {
+      writeValue(out, c.key);
+      writeValue(out, uint8_t(c.isBitset()));
+      if (c.isBitset()) {
+        out.write(reinterpret_cast<const char*>(c.words.data()), c.words.size() * sizeof(uint64_t));
+      } else {
+        writeValue(out, uint32_t(c.values.size()));
+        out.write(reinterpret_cast<const char*>(c.values.data()), c.values.size() * sizeof(uint16_t));
+      }
+    }
+  }
+
+  void read(std::istream& in)
+  {
+    uint32_t n = readValue<uint32_t>(in);
+    mContainers.assign(n, Container{});
+    for (auto& c : mContainers) {
+      c.key = readValue<uint16_t>(in);
+      if (readValue<uint8_t>(in)) {
+        c.words.resize(kBitsetWords);
+        in.read(reinterpret_cast<char*>(c.words.data()), kBitsetWords * sizeof(uint64_t));
+      } else {
+        c.values.resize(readValue<uint32_t>(in));
+        in.read(reinterpret_cast<char*>(c.values.data()), c.values.size() * sizeof(uint16_t));
+      }
+    }
+  }
+
+  template <typename T>
+  static void writeValue(std::ostream& out, T value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template <typename T>
+  static T readValue(std::istream& in)
+  {
+    T value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+  }
+
+ private:
+  static constexpr size_t kMaxArraySize = 4096; // beyond this a bitset is smaller
+  static constexpr size_t kBitsetWords = 1024;  // 2^16 bits
+
+  struct Container {
+    uint16_t key = 0;
+    std::vector<uint16_t> values; // sorted, if array
+    std::vector<uint64_t> words;  // kBitsetWords, if bitset
+    bool isBitset() const { return !words.empty(); }
+    uint64_t cardinality() const
+    {
+      if (!isBitset()) {
+        return values.size();
+      }
+      uint64_t n = 0;
+      for (uint64_t word : words) {
+        n += __builtin_popcountll(word);
+      }
+      return n;
+    }
+    void toBitset()
+    {
+      words.assign(kBitsetWords, 0);
+      for (uint16_t low : values) {
+        words[low >> 6] |= uint64_t(1) << (low & 63);
+      }
+      std::vector<uint16_t>().swap(values);
+    }
+  };
+
+  Container& container(uint16_t key)
+  {
+    // positions are added in increasing order in the filters: the last container is the usual hit
+    if (!mContainers.empty() && mContainers.back().key == key) {
+      return mContainers.back();
+    }
+    auto it = std::lower_bound(mContainers.begin(), mContainers.end(), key, [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == mContainers.end() || it->key != key) {
+      it = mContainers.insert(it, Container{});
+      it->key = key;
+    }
+    return *it;
+  }
+  const Container* find(uint16_t key) const
+  {
+    auto it = std::lower_bound(mContainers.begin(), mContainers.end(), key, [](const Container& c, uint16_t k) { return c.key < k; });
+    return (it == mContainers.end() || it->key != key) ? nullptr : &*it;
+  }
+
+  std::vector<Container> mContainers; // sorted by key
+};
+
+class TriggerBitmapIndex
+{
+ public:
+  struct DataFrame {
+    uint64_t id = 0;             // DF_<id> in the AO2D
+    uint32_t firstCollision = 0; // position of its first collision
+    uint32_t nCollisions = 0;
+  };
+
+  TriggerBitmapIndex() = default;
+  explicit TriggerBitmapIndex(std::vector<std::string> triggerNames) : mTriggerNames(std::move(triggerNames)), mBitmaps(mTriggerNames.size()), mDataFramesWithHits(mTriggerNames.size()) {}
+
+  /// one data frame, with the (row in the data frame, decision word) of its triggered collisions
+  void addDataFrame(uint64_t id, uint32_t nCollisions, const std::vector<std::pair<uint32_t, uint32_t>>& hits)
+  {
+    DataFrame df;
+    df.id = id;
+    df.firstCollision = mDataFrames.empty() ? 0 : mDataFrames.back().firstCollision + mDataFrames.back().nCollisions;
+    df.nCollisions = nCollisions;
+    uint32_t dfIndex = mDataFrames.size();
+    mDataFrames.push_back(df);
+    uint32_t fired = 0;
+    for (const auto& hit : hits) {
+      for (size_t t = 0; t < mBitmaps.size(); t++) {
+        if (hit.second >> t & 1) {
+          mBitmaps[t].add(df.firstCollision + hit.first);
+          fired |= 1u << t;
+        }
+      }
+    }
+    for (size_t t = 0; t < mBitmaps.size(); t++) {
+      if (fired >> t & 1) {
+        mDataFramesWithHits[t].push_back(dfIndex);
+      }
+    }
+  }
+
+  int trigger(const std::string& name) const
+  {
+    auto it = std::find(mTriggerNames.begin(), mTriggerNames.end(), name);
+    return it == mTriggerNames.end() ? -1 : int(it - mTriggerNames.begin());
+  }
+
+  /// data frames with at least one collision passing any trigger of the mask, in processing order
+  std::vector<uint32_t> dataFrames(uint32_t triggerMask) const
+  {
+    std::vector<uint32_t> result;
+    for (size_t t = 0; t < mDataFramesWithHits.size(); t++) {
+      if (triggerMask >> t & 1) {
+        result.insert(result.end(), mDataFramesWithHits[t].begin(), mDataFramesWithHits[t].end());
+      }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  /// rows of the triggered collisions inside one data frame, in increasing order
+  std::vector<uint32_t> rows(uint32_t triggerMask, uint32_t dfIndex) const
+  {
+    const DataFrame& df = mDataFrames[dfIndex];
+    std::vector<uint32_t> result;
+    for (size_t t = 0; t < mBitmaps.size(); t++) {
+      if (triggerMask >> t & 1) {
+        for (uint32_t position : mBitmaps[t].range(df.firstCollision, df.nCollisions)) {
+          result.push_back(position - df.firstCollision);
+        }
+      }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  const std::vector<DataFrame>& dataFrameTable() const { return mDataFrames; }
+  const RoaringBitmap& bitmap(int trigger) const { return mBitmaps[trigger]; }
+  const std::vector<std::string>& triggerNames() const { return mTriggerNames; }
+
+  bool write(const std::string& fileName) const
+  {
+    std::ofstream out(fileName, std::ios::binary);
+    RoaringBitmap::writeValue(out, kMagic);
+    RoaringBitmap::writeValue(out, uint32_t(mTriggerNames.size()));
+    for (size_t t = 0; t < mTriggerNames.size(); t++) {
+      RoaringBitmap::writeValue(out, uint32_t(mTriggerNames[t].size()));
+      out.write(mTriggerNames[t].data(), mTriggerNames[t].size());
+      mBitmaps[t].write(out);
+      RoaringBitmap::writeValue(out, uint32_t(mDataFramesWithHits[t].size()));
+      out.write(reinterpret_cast<const char*>(mDataFramesWithHits[t].data()), mDataFramesWithHits[t].size() * sizeof(uint32_t));
+    }
+    RoaringBitmap::writeValue(out, uint32_t(mDataFrames.size()));
+    for (const auto& df : mDataFrames) {
+      RoaringBitmap::writeValue(out, df.id);
+      RoaringBitmap::writeValue(out, df.firstCollision);
+      RoaringBitmap::writeValue(out, df.nCollisions);
+    }
+    return bool(out);
+  }
+
+  bool read(const std::string& fileName)
+  {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in || RoaringBitmap::readValue<uint32_t>(in) != kMagic) {
+      return false;
+    }
+    uint32_t nTriggers = RoaringBitmap::readValue<uint32_t>(in);
+    mTriggerNames.assign(nTriggers, "");
+    mBitmaps.assign(nTriggers, RoaringBitmap{});
+    mDataFramesWithHits.assign(nTriggers, {});
+    for (uint32_t t = 0; t < nTriggers; t++) {
+      mTriggerNames[t].resize(RoaringBitmap::readValue<uint32_t>(in));
+      in.read(&mTriggerNames[t][0], mTriggerNames[t].size());
+      mBitmaps[t].read(in);
+      mDataFramesWithHits[t].resize(RoaringBitmap::readValue<uint32_t>(in));
+      in.read(reinterpret_cast<char*>(mDataFramesWithHits[t].data()), mDataFramesWithHits[t].size() * sizeof(uint32_t));
+    }
+    mDataFrames.resize(RoaringBitmap::readValue<uint32_t>(in));
+    for (auto& df : mDataFrames) {
+      df.id = RoaringBitmap::readValue<uint64_t>(in);
+      df.firstCollision = RoaringBitmap::readValue<uint32_t>(in);
+      df.nCollisions = RoaringBitmap::readValue<uint32_t>(in);
+    }
+    return bool(in);
+  }
+
+ private:
+  static constexpr uint32_t kMagic = 0x58494254; // "TBIX"
+
+  std::vector<std::string> mTriggerNames;                   // bit i of the decision word
+  std::vector<RoaringBitmap> mBitmaps;                      // per trigger
+  std::vector<std::vector<uint32_t>> mDataFramesWithHits;   // per trigger, indices in mDataFrames
+  std::vector<DataFrame> mDataFrames;                       // processing order
+};
+
+} // namespace o2::filtering
+
+#endif // O2_ANALYSIS_TRIGGER_BITMAP_INDEX_H_
@@ -0,0 +1,168 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file triggerRateController.h
+/// \brief Per-bit downscale factors adjusted to target accept rates over a sliding time window.
+///
+/// Time is the global BC of the collisions, split in slots of windowSeconds / nSlots: the raw
+/// (not downscaled) accepts of each bit are counted per slot in a ring, and at every slot
+/// boundary the raw rate over the last nSlots slots sets the downscale of the bit, moved from
+/// its current value towards rawRate / targetRate by the gain (geometric step), within
+/// [1, maxDownscale]. No change while rawRate / targetRate is within the tolerance of the
+/// downscale. Every change is recorded as an Adjustment, for the normalisation offline.
+/// A downscaled bit is kept when a hash of (global BC, bit) is below 2^32 / downscale: the
+/// decisions depend only on the collisions and on the factors, never on a counter or a random
+/// state, so that reprocessing the same input gives the same triggers.
+/// Collisions must come roughly in time order; earlier ones are counted in the current slot.
+/// A controller only sees the collisions given to it: when the task runs with --pipeline N,
+/// each of the N instances gets about one time frame in N and would measure 1/N of the rate.
+/// configure() takes the number of instances to scale the counts back; this assumes the time
+/// frames are dealt round-robin and the window spans many of them. Each instance then sets its
+/// own factors on its own share of the collisions, so run un-pipelined for exact rates.
+/// No O2 or ROOT dependency, so that the benchmark macros can use it.
+
+#ifndef O2_ANALYSIS_TRIGGER_RATE_CONTROLLER_H_
+#define O2_ANALYSIS_TRIGGER_RATE_CONTROLLER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace o2::filtering
+{
+
+class TriggerRateController
+{
+ public:
+  struct Adjustment {
+    uint64_t globalBC; // first BC of the slot from which the downscale applies
+    int bit;
+    float rawRate;   // Hz, over the window
+    float downscale; // new factor
+  };
+
+  static constexpr double kBunchSpacingNS = 24.95;
+
+  TriggerRateController() = default;
+
+  /// targetRates in Hz per decision bit, 0: bit never downscaled; nInstances: pipelined copies of the task
+  void configure(std::vector<float> targetRates, double windowSeconds, int nSlots, float maxDownscale, float gain, float tolerance, int nInstances = 1)
+  {
+    mInstances = std::max(nInstances, 1);
+    mTargets = std::move(targetRates);
+    mNSlots = std::max(nSlots, 1);
+    mSlotBCs = std::max<uint64_t>(1, std::llround(windowSeconds / mNSlots / (kBunchSpacingNS * 1.e-9)));
+    mMaxDownscale = std::max(maxDownscale, 1.f);
+    mGain = std::clamp(gain, 0.f, 1.f);
+    mTolerance = tolerance;
+    mCounts.assign(mNSlots * mTargets.size(), 0);
+    mDownscales.assign(mTargets.size(), 1.f);
+    mThresholds.assign(mTargets.size(), kAll);
+    mSlot = -1;
+    mFilledSlots = 0;
+    mAdjustments.clear();
+  }
+
+  /// counts the raw decisions of a collision and returns them downscaled
+  uint32_t apply(uint64_t globalBC, uint32_t decisions)
+  {
+    const int64_t slot = globalBC / mSlotBCs;
+    if (slot > mSlot) {
+      advance(slot);
+    }
+    uint32_t kept = decisions;
+    uint32_t* counts = mCounts.data() + (mSlot % mNSlots) * mTargets.size();
+    for (uint32_t bits = decisions; bits; bits &= bits - 1) {
+      const int bit = __builtin_ctz(bits);
+      if (bit >= int(mTargets.size())) {
+        break;
+      }
+      counts[bit]++;
+      if (mThresholds[bit] != kAll && hash(globalBC, bit) >= mThresholds[bit]) {
+        kept &= ~(uint32_t(1) << bit);
+      }
+    }
+    return kept;
+  }
+
+  /// changes since the last clearAdjustments
+  const std::vector<Adjustment>& adjustments() const { return mAdjustments; }
+  void clearAdjustments() { mAdjustments.clear(); }
+  float downscale(int bit) const { return mDownscales[bit]; }
+  double slotSeconds() const { return mSlotBCs * kBunchSpacingNS * 1.e-9; }
+
+ private:
+  static constexpr uint64_t kAll = uint64_t(1) << 32; // threshold of a bit that is not downscaled
+
+  /// splitmix64 finaliser, low 32 bits
+  static uint64_t hash(uint64_t globalBC, int bit)
+  {
+    uint64_t x = (globalBC << 5 | bit) + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return (x ^ (x >> 31)) & 0xFFFFFFFFULL;
+  }
+
+  /// closes the current slot, updates the downscales and clears the slots up to the new one
+  void advance(int64_t slot)
+  {
+    const size_t nBits = mTargets.size();
+    if (mSlot >= 0) {
+      mFilledSlots = std::min(mFilledSlots + 1, mNSlots);
+      const double seconds = mFilledSlots * slotSeconds();
+      for (size_t bit = 0; bit < nBits; bit++) {
+        if (mTargets[bit] <= 0.f) {
+          continue;
+        }
+        uint64_t n = 0;
+        for (int s = 0; s < mNSlots; s++) {
+          n += mCounts[s * nBits + bit];
+        }
+        const float rawRate = n * mInstances / seconds;
+        const float wanted = std::clamp(rawRate / mTargets[bit], 1.f, mMaxDownscale);
+        if (std::fabs(wanted - mDownscales[bit]) > mTolerance * mDownscales[bit]) {
+          const float factor = std::clamp(std::exp((1.f - mGain) * std::log(mDownscales[bit]) + mGain * std::log(wanted)), 1.f, mMaxDownscale);
+          mDownscales[bit] = factor;
+          mThresholds[bit] = factor > 1.f ? uint64_t(double(kAll) / factor) : kAll;
+          mAdjustments.push_back({uint64_t(slot) * mSlotBCs, int(bit), rawRate, factor});
+        }
+      }
+    }
+    // slots skipped by a gap in time count as empty
+    const int64_t first = mSlot < 0 ? slot : std::max(mSlot + 1, slot - mNSlots + 1);
+    for (int64_t s = first; s <= slot; s++) {
+      std::fill_n(mCounts.begin() + (s % mNSlots) * nBits, nBits, 0);
+    }
+    if (mSlot >= 0) {
+      mFilledSlots = std::min<int64_t>(mFilledSlots + (slot - mSlot - 1), mNSlots);
+    }
+    mSlot = slot;
+  }
+
+  std::vector<float> mTargets;
+  std::vector<uint32_t> mCounts; // [slot % nSlots][bit], raw accepts
+  std::vector<float> mDownscales;
+  std::vector<uint64_t> mThresholds; // hash threshold of each bit, kAll if not downscaled
+  std::vector<Adjustment> mAdjustments;
+  uint64_t mSlotBCs = 1;
+  int64_t mSlot = -1; // current slot
+  int mNSlots = 1;
+  int mFilledSlots = 0; // closed slots in the window
+  int mInstances = 1;   // pipelined instances sharing the collisions
+  float mMaxDownscale = 1.f;
+  float mGain = 1.f;
+  float mTolerance = 0.f;
+};
+
+} // namespace o2::filtering
+
+#endif // O2_ANALYSIS_TRIGGER_RATE_CONTROLLER_H_